@@ -11,7 +11,8 @@ struct Student {
     int grade { };
 };
 
-bool greatest_grade(Student a, Student b)
+// By const reference: by value, every comparison would copy both names
+bool greatest_grade(const Student& a, const Student& b)
 {
     return (a.grade > b.grade);
 }
@@ -57,6 +57,37 @@ void selectionSort(int* array, int size, bool (*comparisonFcn)(int, int) = ascen
     }
 }
 
+// Same sort, but the comparison is a template parameter, so every lambda or functor gets its own
+// copy of the sort with the comparison inlined (no call through a pointer per comparison).
+// Passing a plain function name still picks the function pointer version above, because a
+// non-template function wins over a template when both match equally well.
+template <typename Compare>
+void selectionSort(int* array, int size, Compare comparisonFcn)
+{
+    for (int startIndex { 0 }; startIndex < (size - 1); ++startIndex)
+    {
+        int bestIndex { startIndex };
+
+        for (int currentIndex { startIndex + 1 }; currentIndex < size; ++currentIndex)
+        {
+            if (comparisonFcn(array[bestIndex], array[currentIndex]))
+            {
+                bestIndex = currentIndex;
+            }
+        }
+
+        std::swap(array[startIndex], array[bestIndex]);
+    }
+}
+
+struct Descending
+{
+    bool operator()(int x, int y) const
+    {
+        return descending(x, y);
+    }
+};
+
 int main()
 {
     int array[9] { 3, 7, 9, 5, 6, 1, 8, 2, 4 };
@@ -74,5 +105,13 @@ int main()
     selectionSort(array, 9);
     printArray(array, 9);
 
+    // templated version: functor
+    selectionSort(array, 9, Descending { });
+    printArray(array, 9);
+
+    // templated version: lambda wrapping a named function, so it gets inlined too
+    selectionSort(array, 9, [](int x, int y) { return evensFirst(x, y); });
+    printArray(array, 9);
+
     return 0;
 }
@@ -1,9 +1,9 @@
 // 12.x - Q3
 
+#include <cstddef> // for std::size_t
 #include <iostream>
-#include <iterator>
 
-int binarySearch(const int* array, int target, int min, int max)
+constexpr int binarySearch(const int* array, int target, int min, int max)
 {
     while (min <= max)
     {
@@ -26,7 +26,7 @@ int binarySearch(const int* array, int target, int min, int max)
     return -1;
 }
 
-int binarySearchRec(const int* array, int target, int min, int max)
+constexpr int binarySearchRec(const int* array, int target, int min, int max)
 {
     if (min > max)
     {
@@ -48,44 +48,35 @@ int binarySearchRec(const int* array, int target, int min, int max)
     }
 }
 
-int main()
+// Runs every test value through search; constexpr, so the tests can run at compile time
+template <std::size_t ArraySize, std::size_t TestCount>
+constexpr bool passesTests(int (*search)(const int*, int, int, int), const int (&array)[ArraySize],
+    const int (&testValues)[TestCount], const int (&expectedValues)[TestCount])
 {
-    //                      0                         7                          14
-    constexpr int array[] { 3, 6, 8, 12, 14, 17, 20, 21, 26, 32, 36, 37, 42, 44, 48 };
-
-    constexpr int numTestValues { 9 };
-    constexpr int testValues[numTestValues] { 0,  3, 12, 13, 22, 26, 43, 44, 49 };
-    int expectedValues[numTestValues]       { -1, 0, 3,  -1, -1, 8,  -1, 13, -1 };
-
-    std::cout << "Testing iterative function\n";
-    for (int count { 0 }; count < numTestValues; ++count)
+    for (std::size_t count { 0 }; count < TestCount; ++count)
     {
-        int index { binarySearch(array, testValues[count], 0, static_cast<int>(std::size(array)) - 1) };
-
-        if (index == expectedValues[count])
-        {
-            std::cout << "test value " << testValues[count] << " passed!\n";
-        }
-        else
+        if (search(array, testValues[count], 0, static_cast<int>(ArraySize) - 1) != expectedValues[count])
         {
-            std::cout << "test value " << testValues[count] << " failed.\n";
+            return false;
         }
     }
 
-    std::cout << "Testing recursive function\n";
-    for (int count { 0 }; count < numTestValues; ++count)
-    {
-        int index { binarySearchRec(array, testValues[count], 0, static_cast<int>(std::size(array)) - 1) };
+    return true;
+}
 
-        if (index == expectedValues[count])
-        {
-            std::cout << "test value " << testValues[count] << " passed!\n";
-        }
-        else
-        {
-            std::cout << "test value " << testValues[count] << " failed.\n";
-        }
-    }
+int main()
+{
+    //                             0                         7                          14
+    static constexpr int array[] { 3, 6, 8, 12, 14, 17, 20, 21, 26, 32, 36, 37, 42, 44, 48 };
+
+    static constexpr int testValues[]     { 0,  3, 12, 13, 22, 26, 43, 44, 49 };
+    static constexpr int expectedValues[] { -1, 0, 3,  -1, -1, 8,  -1, 13, -1 };
+
+    // a failing test now stops the build instead of printing "failed."
+    static_assert(passesTests(binarySearch, array, testValues, expectedValues), "iterative function failed");
+    static_assert(passesTests(binarySearchRec, array, testValues, expectedValues), "recursive function failed");
+
+    std::cout << "Iterative and recursive functions passed all tests (at compile time)\n";
 
     return 0;
 }
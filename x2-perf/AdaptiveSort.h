@@ -0,0 +1,401 @@
+#ifndef ADAPTIVESORT_H
+#define ADAPTIVESORT_H
+
+#include <algorithm>
+#include <cstddef> // for std::size_t
+#include <functional> // for std::less
+#include <iterator> // for std::make_move_iterator
+#include <span>
+#include <utility> // for std::move
+#include <vector>
+
+// Stable adaptive merge sort in the style of TimSort.
+//
+// bubble_sort.cpp stops as soon as a pass makes no swaps; this takes the same idea further.
+// The input is cut into natural runs (strictly descending runs are reversed in place), short
+// runs are extended to minRun with binary insertion sort, and runs are merged from a stack that
+// keeps their lengths balanced. When one side of a merge keeps winning, the merge switches to
+// galloping (exponential search) and moves whole blocks at once.
+//
+// Already sorted input is a single run and costs n - 1 comparisons; a sorted log with a batch
+// appended costs roughly the batch plus one galloping merge.
+
+namespace adaptive
+{
+    inline constexpr std::size_t g_minGallop { 7 };
+
+    inline std::size_t computeMinRun(std::size_t size)
+    {
+        std::size_t lowBits { 0 };
+        while (size >= 64)
+        {
+            lowBits |= size & 1;
+            size >>= 1;
+        }
+
+        return size + lowBits;
+    }
+
+    // Returns the length of the run starting at first, reversing it if it is descending
+    template <typename T, typename Compare>
+    std::size_t makeAscendingRun(T* first, T* last, Compare& comp)
+    {
+        T* runEnd { first + 1 };
+        if (runEnd == last)
+        {
+            return 1;
+        }
+
+        // only strictly descending runs may be reversed, or equal elements would swap order
+        if (comp(*runEnd, *first))
+        {
+            while (runEnd != last && comp(*runEnd, *(runEnd - 1)))
+            {
+                ++runEnd;
+            }
+
+            std::reverse(first, runEnd);
+        }
+        else
+        {
+            while (runEnd != last && !comp(*runEnd, *(runEnd - 1)))
+            {
+                ++runEnd;
+            }
+        }
+
+        return static_cast<std::size_t>(runEnd - first);
+    }
+
+    // [first, sortedEnd) is sorted already
+    template <typename T, typename Compare>
+    void binaryInsertionSort(T* first, T* last, T* sortedEnd, Compare& comp)
+    {
+        for (T* current { sortedEnd }; current != last; ++current)
+        {
+            T pivot { std::move(*current) };
+            T* position { std::upper_bound(first, current, pivot, comp) };
+
+            std::move_backward(position, current, current + 1);
+            *position = std::move(pivot);
+        }
+    }
+
+    // [first, last) holds elements with pred true, then false. Returns the first false one,
+    // probing first[0], first[1], first[3], first[7], ... before the binary search.
+    template <typename T, typename Pred>
+    T* gallopFront(T* first, T* last, Pred pred)
+    {
+        const auto length { static_cast<std::size_t>(last - first) };
+        std::size_t known { 0 }; // first[0, known) are all true
+        std::size_t offset { 0 };
+
+        while (offset < length && pred(first[offset]))
+        {
+            known = offset + 1;
+            offset = offset * 2 + 1;
+        }
+
+        return std::partition_point(first + known, first + std::min(offset, length), pred);
+    }
+
+    // [first, last) holds elements with pred false, then true. Returns the first true one,
+    // probing from the back.
+    template <typename T, typename Pred>
+    T* gallopBack(T* first, T* last, Pred pred)
+    {
+        const auto length { static_cast<std::size_t>(last - first) };
+        std::size_t known { 0 }; // the last known elements are all true
+        std::size_t offset { 0 };
+
+        while (offset < length && pred(*(last - 1 - offset)))
+        {
+            known = offset + 1;
+            offset = offset * 2 + 1;
+        }
+
+        T* start { (offset >= length) ? first : last - offset };
+        return std::partition_point(start, last - known, [&pred](const T& value) { return !pred(value); });
+    }
+
+    template <typename T, typename Compare>
+    class RunMerger
+    {
+    private:
+        struct Run
+        {
+            std::size_t start { };
+            std::size_t length { };
+        };
+
+        T* m_array { nullptr };
+        Compare& m_comp;
+        std::vector<Run> m_runs { };
+        std::vector<T> m_tmp { };
+        std::size_t m_minGallop { g_minGallop };
+
+        // a and b are adjacent, lenA <= lenB, a[0] > b[0] and a[lenA - 1] > b[lenB - 1]
+        void mergeLo(T* a, std::size_t lenA, T* b, std::size_t lenB)
+        {
+            m_tmp.assign(std::make_move_iterator(a), std::make_move_iterator(a + lenA));
+
+            T* left { m_tmp.data() };
+            T* leftEnd { left + lenA };
+            T* right { b };
+            T* rightEnd { b + lenB };
+            T* dest { a };
+
+            while (left != leftEnd && right != rightEnd)
+            {
+                std::size_t leftWins { 0 };
+                std::size_t rightWins { 0 };
+
+                while (left != leftEnd && right != rightEnd && leftWins < m_minGallop && rightWins < m_minGallop)
+                {
+                    if (m_comp(*right, *left))
+                    {
+                        *dest++ = std::move(*right++);
+                        ++rightWins;
+                        leftWins = 0;
+                    }
+                    else
+                    {
+                        *dest++ = std::move(*left++);
+                        ++leftWins;
+                        rightWins = 0;
+                    }
+                }
+
+                while (left != leftEnd && right != rightEnd)
+                {
+                    // everything on the left that is <= *right keeps going first (stability)
+                    T* leftStop { gallopFront(left, leftEnd, [&](const T& x) { return !m_comp(*right, x); }) };
+                    leftWins = static_cast<std::size_t>(leftStop - left);
+                    dest = std::move(left, leftStop, dest);
+                    left = leftStop;
+
+                    if (left == leftEnd)
+                    {
+                        break;
+                    }
+
+                    T* rightStop { gallopFront(right, rightEnd, [&](const T& x) { return m_comp(x, *left); }) };
+                    rightWins = static_cast<std::size_t>(rightStop - right);
+                    dest = std::move(right, rightStop, dest);
+                    right = rightStop;
+
+                    if (leftWins < g_minGallop && rightWins < g_minGallop)
+                    {
+                        ++m_minGallop; // galloping didn't pay off, make it harder to enter again
+                        break;
+                    }
+
+                    if (m_minGallop > 1)
+                    {
+                        --m_minGallop;
+                    }
+                }
+            }
+
+            // whatever is left of the right run is already in place
+            std::move(left, leftEnd, dest);
+        }
+
+        // Mirror image of mergeLo for lenA > lenB: b goes to m_tmp and the merge runs backwards
+        void mergeHi(T* a, std::size_t lenA, T* b, std::size_t lenB)
+        {
+            m_tmp.assign(std::make_move_iterator(b), std::make_move_iterator(b + lenB));
+
+            T* leftBegin { a };
+            T* left { a + lenA };
+            T* rightBegin { m_tmp.data() };
+            T* right { rightBegin + lenB };
+            T* dest { b + lenB };
+
+            while (left != leftBegin && right != rightBegin)
+            {
+                std::size_t leftWins { 0 };
+                std::size_t rightWins { 0 };
+
+                while (left != leftBegin && right != rightBegin && leftWins < m_minGallop && rightWins < m_minGallop)
+                {
+                    if (m_comp(*(right - 1), *(left - 1)))
+                    {
+                        *--dest = std::move(*--left);
+                        ++leftWins;
+                        rightWins = 0;
+                    }
+                    else
+                    {
+                        *--dest = std::move(*--right);
+                        ++rightWins;
+                        leftWins = 0;
+                    }
+                }
+
+                while (left != leftBegin && right != rightBegin)
+                {
+                    // everything on the right that is >= the last left element stays at the back
+                    T* rightStart { gallopBack(rightBegin, right, [&](const T& x) { return !m_comp(x, *(left - 1)); }) };
+                    rightWins = static_cast<std::size_t>(right - rightStart);
+                    dest = std::move_backward(rightStart, right, dest);
+                    right = rightStart;
+
+                    if (right == rightBegin)
+                    {
+                        break;
+                    }
+
+                    T* leftStart { gallopBack(leftBegin, left, [&](const T& x) { return m_comp(*(right - 1), x); }) };
+                    leftWins = static_cast<std::size_t>(left - leftStart);
+                    dest = std::move_backward(leftStart, left, dest);
+                    left = leftStart;
+
+                    if (leftWins < g_minGallop && rightWins < g_minGallop)
+                    {
+                        ++m_minGallop;
+                        break;
+                    }
+
+                    if (m_minGallop > 1)
+                    {
+                        --m_minGallop;
+                    }
+                }
+            }
+
+            // whatever is left of the left run is already in place
+            std::move_backward(rightBegin, right, dest);
+        }
+
+        void mergeAt(std::size_t index)
+        {
+            Run& runA { m_runs[index] };
+            const Run& runB { m_runs[index + 1] };
+
+            T* a { m_array + runA.start };
+            T* b { m_array + runB.start };
+            T* aEnd { b };
+            T* bEnd { b + runB.length };
+
+            runA.length += runB.length;
+            m_runs.erase(m_runs.begin() + static_cast<std::ptrdiff_t>(index) + 1);
+
+            // elements of a that are <= b[0] are already in place
+            a = gallopFront(a, aEnd, [&](const T& x) { return !m_comp(*b, x); });
+            if (a == aEnd)
+            {
+                return;
+            }
+
+            // elements of b that are >= the last element of a are already in place
+            bEnd = gallopBack(b, bEnd, [&](const T& x) { return !m_comp(x, *(aEnd - 1)); });
+            if (bEnd == b)
+            {
+                return;
+            }
+
+            auto lenA { static_cast<std::size_t>(aEnd - a) };
+            auto lenB { static_cast<std::size_t>(bEnd - b) };
+
+            if (lenA <= lenB)
+            {
+                mergeLo(a, lenA, b, lenB);
+            }
+            else
+            {
+                mergeHi(a, lenA, b, lenB);
+            }
+        }
+
+    public:
+        RunMerger(T* array, Compare& comp)
+            : m_array { array }, m_comp { comp }
+        {
+        }
+
+        RunMerger(const RunMerger&) = delete;
+        RunMerger& operator=(const RunMerger&) = delete;
+
+        void pushRun(std::size_t start, std::size_t length)
+        {
+            m_runs.push_back({ start, length });
+        }
+
+        // Keeps run lengths growing at least like Fibonacci numbers from the top of the stack down,
+        // so the stack stays O(log n) deep and merges stay balanced
+        void mergeCollapse()
+        {
+            while (m_runs.size() > 1)
+            {
+                std::size_t n { m_runs.size() - 2 };
+
+                if ((n > 0 && m_runs[n - 1].length <= m_runs[n].length + m_runs[n + 1].length)
+                    || (n > 1 && m_runs[n - 2].length <= m_runs[n - 1].length + m_runs[n].length))
+                {
+                    if (m_runs[n - 1].length < m_runs[n + 1].length)
+                    {
+                        --n;
+                    }
+                }
+                else if (m_runs[n].length > m_runs[n + 1].length)
+                {
+                    break;
+                }
+
+                mergeAt(n);
+            }
+        }
+
+        void mergeForceCollapse()
+        {
+            while (m_runs.size() > 1)
+            {
+                std::size_t n { m_runs.size() - 2 };
+
+                if (n > 0 && m_runs[n - 1].length < m_runs[n + 1].length)
+                {
+                    --n;
+                }
+
+                mergeAt(n);
+            }
+        }
+    };
+}
+
+template <typename T, typename Compare = std::less<>>
+void adaptiveSort(std::span<T> array, Compare comp = Compare { })
+{
+    const std::size_t size { array.size() };
+    if (size < 2)
+    {
+        return;
+    }
+
+    T* data { array.data() };
+    const std::size_t minRun { adaptive::computeMinRun(size) };
+
+    adaptive::RunMerger<T, Compare> merger { data, comp };
+
+    for (std::size_t start { 0 }; start < size; )
+    {
+        std::size_t runLength { adaptive::makeAscendingRun(data + start, data + size, comp) };
+
+        if (runLength < minRun)
+        {
+            std::size_t forced { std::min(minRun, size - start) };
+            adaptive::binaryInsertionSort(data + start, data + start + forced, data + start + runLength, comp);
+            runLength = forced;
+        }
+
+        merger.pushRun(start, runLength);
+        merger.mergeCollapse();
+
+        start += runLength;
+    }
+
+    merger.mergeForceCollapse();
+}
+
+#endif
@@ -0,0 +1,249 @@
+#include "Benchmark.h"
+#include "Timer.h"
+
+#include <algorithm>
+#include <cmath> // for std::sqrt
+#include <cstddef> // for std::size_t
+#include <iomanip>
+#include <iostream>
+#include <numeric> // for std::accumulate
+#include <string_view>
+#include <utility> // for std::move
+
+namespace
+{
+    double timeRun(const BenchmarkCase& benchmarkCase)
+    {
+        if (benchmarkCase.setup)
+        {
+            benchmarkCase.setup();
+        }
+
+        Timer t;
+        benchmarkCase.run();
+
+        return t.elapsed();
+    }
+
+    // Nearest-rank percentile over already sorted samples
+    double percentile(const std::vector<double>& sorted, double fraction)
+    {
+        auto rank { static_cast<std::size_t>(std::ceil(fraction * static_cast<double>(sorted.size()))) };
+
+        return sorted[std::clamp<std::size_t>(rank, 1, sorted.size()) - 1];
+    }
+
+    void printJsonString(std::ostream& out, std::string_view string)
+    {
+        out << '"';
+
+        for (char c : string)
+        {
+            if (c == '"' || c == '\\')
+            {
+                out << '\\';
+            }
+
+            out << c;
+        }
+
+        out << '"';
+    }
+
+    void printCsvString(std::ostream& out, std::string_view string)
+    {
+        if (string.find_first_of(",\"") == std::string_view::npos)
+        {
+            out << string;
+            return;
+        }
+
+        out << '"';
+
+        for (char c : string)
+        {
+            if (c == '"')
+            {
+                out << '"';
+            }
+
+            out << c;
+        }
+
+        out << '"';
+    }
+
+    double perSecond(double amount, double seconds)
+    {
+        return (amount > 0.0 && seconds > 0.0) ? amount / seconds : 0.0;
+    }
+}
+
+BenchmarkResult runBenchmark(const BenchmarkCase& benchmarkCase, const BenchmarkOptions& options)
+{
+    BenchmarkResult result { };
+    result.group = benchmarkCase.group;
+    result.name = benchmarkCase.name;
+    result.items = benchmarkCase.items;
+    result.bytes = benchmarkCase.bytes;
+    result.threads = std::max(1u, benchmarkCase.threads);
+
+    // The first run doubles as a correctness check and as the pilot for the repeat count
+    double pilot { timeRun(benchmarkCase) };
+
+    if (benchmarkCase.check)
+    {
+        result.checkPassed = benchmarkCase.check();
+    }
+
+    for (int i { 1 }; i < options.warmupRuns; ++i)
+    {
+        pilot = std::min(pilot, timeRun(benchmarkCase));
+    }
+
+    int runs { options.maxRuns };
+    if (pilot > 0.0)
+    {
+        runs = static_cast<int>(std::min(options.targetSeconds / pilot, static_cast<double>(options.maxRuns)));
+    }
+    runs = std::clamp(runs, options.minRuns, std::max(options.minRuns, options.maxRuns));
+
+    std::vector<double> samples(static_cast<std::size_t>(runs));
+    for (auto& sample : samples)
+    {
+        sample = timeRun(benchmarkCase);
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    result.runs = runs;
+    result.min = samples.front();
+    result.median = percentile(samples, 0.5);
+    result.p95 = percentile(samples, 0.95);
+    result.p99 = percentile(samples, 0.99);
+    result.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(runs);
+
+    double squares { 0.0 };
+    for (double sample : samples)
+    {
+        squares += (sample - result.mean) * (sample - result.mean);
+    }
+    result.stddev = (runs > 1) ? std::sqrt(squares / static_cast<double>(runs - 1)) : 0.0;
+
+    return result;
+}
+
+Reporter::Reporter(std::ostream& out, OutputFormat format)
+    : m_out { out }, m_format { format }
+{
+}
+
+void Reporter::begin()
+{
+    switch (m_format)
+    {
+        case OutputFormat::text:
+            m_out << std::left << std::setw(36) << "group" << std::setw(28) << "name"
+                << std::right << std::setw(8) << "runs"
+                << std::setw(12) << "min(ms)" << std::setw(12) << "median(ms)"
+                << std::setw(12) << "p95(ms)" << std::setw(12) << "p99(ms)"
+                << std::setw(12) << "stddev(ms)" << std::setw(12) << "Mitems/s"
+                << std::setw(10) << "GB/s" << std::setw(14) << "Mitems/s/core" << '\n';
+            break;
+        case OutputFormat::csv:
+            m_out << "group,name,runs,min_s,median_s,p95_s,p99_s,mean_s,stddev_s,items,bytes,"
+                "items_per_s,bytes_per_s,threads,items_per_s_per_core,check\n";
+            break;
+        case OutputFormat::json:
+            m_out << "[\n";
+            break;
+    }
+}
+
+void Reporter::print(const BenchmarkResult& result)
+{
+    double itemsPerSecond { perSecond(result.items, result.median) };
+    double bytesPerSecond { perSecond(result.bytes, result.median) };
+    double itemsPerCoreSecond { itemsPerSecond / result.threads };
+
+    switch (m_format)
+    {
+        case OutputFormat::text:
+            m_out << std::left << std::setw(36) << result.group << std::setw(28) << result.name
+                << std::right << std::setw(8) << result.runs << std::fixed << std::setprecision(4)
+                << std::setw(12) << result.min * 1e3 << std::setw(12) << result.median * 1e3
+                << std::setw(12) << result.p95 * 1e3 << std::setw(12) << result.p99 * 1e3
+                << std::setw(12) << result.stddev * 1e3 << std::setprecision(2)
+                << std::setw(12) << itemsPerSecond / 1e6 << std::setw(10) << bytesPerSecond / 1e9
+                << std::setw(14) << itemsPerCoreSecond / 1e6
+                << std::defaultfloat << (result.checkPassed ? "" : "  CHECK FAILED") << '\n';
+            break;
+        case OutputFormat::csv:
+            printCsvString(m_out, result.group);
+            m_out << ',';
+            printCsvString(m_out, result.name);
+            m_out << std::setprecision(9) << ',' << result.runs << ',' << result.min << ',' << result.median
+                << ',' << result.p95 << ',' << result.p99 << ',' << result.mean << ',' << result.stddev
+                << ',' << result.items << ',' << result.bytes << ',' << itemsPerSecond << ','
+                << bytesPerSecond << ',' << result.threads << ',' << itemsPerCoreSecond << ','
+                << (result.checkPassed ? "pass" : "fail") << '\n';
+            break;
+        case OutputFormat::json:
+            m_out << (m_printed > 0 ? ",\n" : "") << "  { \"group\": ";
+            printJsonString(m_out, result.group);
+            m_out << ", \"name\": ";
+            printJsonString(m_out, result.name);
+            m_out << std::setprecision(9) << ", \"runs\": " << result.runs << ", \"min\": " << result.min
+                << ", \"median\": " << result.median << ", \"p95\": " << result.p95
+                << ", \"p99\": " << result.p99 << ", \"mean\": " << result.mean
+                << ", \"stddev\": " << result.stddev << ", \"items\": " << result.items
+                << ", \"bytes\": " << result.bytes << ", \"itemsPerSecond\": " << itemsPerSecond
+                << ", \"bytesPerSecond\": " << bytesPerSecond << ", \"threads\": " << result.threads
+                << ", \"itemsPerCoreSecond\": " << itemsPerCoreSecond
+                << ", \"check\": " << (result.checkPassed ? "true" : "false") << " }";
+            break;
+    }
+
+    m_out.flush();
+    ++m_printed;
+}
+
+void Reporter::end()
+{
+    if (m_format == OutputFormat::json)
+    {
+        m_out << (m_printed > 0 ? "\n" : "") << "]\n";
+    }
+}
+
+void BenchmarkSuite::add(BenchmarkCase benchmarkCase)
+{
+    m_cases.push_back(std::move(benchmarkCase));
+}
+
+int BenchmarkSuite::run(const BenchmarkOptions& options, Reporter& reporter) const
+{
+    int failed { 0 };
+
+    reporter.begin();
+
+    for (const auto& benchmarkCase : m_cases)
+    {
+        if ((benchmarkCase.group + '/' + benchmarkCase.name).find(options.filter) == std::string::npos)
+        {
+            continue;
+        }
+
+        BenchmarkResult result { runBenchmark(benchmarkCase, options) };
+        if (!result.checkPassed)
+        {
+            ++failed;
+        }
+
+        reporter.print(result);
+    }
+
+    reporter.end();
+
+    return failed;
+}
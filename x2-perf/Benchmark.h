@@ -0,0 +1,84 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+enum class OutputFormat
+{
+    text,
+    csv,
+    json,
+};
+
+struct BenchmarkOptions
+{
+    int warmupRuns { 2 };
+    double targetSeconds { 0.5 }; // timed wall time we aim for per case
+    int minRuns { 5 };
+    int maxRuns { 100000 };
+    std::string filter { };       // only run cases whose "group/name" contains this
+};
+
+struct BenchmarkCase
+{
+    std::string group { };           // what is measured, e.g. "sort/reversed/10000"
+    std::string name { };            // who is measured, e.g. "std::sort"
+    std::function<void()> setup { }; // untimed, called before every run (may be empty)
+    std::function<void()> run { };   // timed
+    std::function<bool()> check { }; // untimed, called once after the first run (may be empty)
+    double items { };                // items processed per run, 0 if not meaningful
+    double bytes { };                // bytes processed per run, 0 if not meaningful
+    unsigned threads { 1 };          // threads a run keeps busy, for the per-core throughput
+};
+
+struct BenchmarkResult
+{
+    std::string group { };
+    std::string name { };
+    int runs { };
+    double min { };
+    double median { };
+    double p95 { };
+    double p99 { };
+    double mean { };
+    double stddev { };
+    double items { };
+    double bytes { };
+    unsigned threads { 1 };
+    bool checkPassed { true };
+};
+
+BenchmarkResult runBenchmark(const BenchmarkCase& benchmarkCase, const BenchmarkOptions& options);
+
+// Prints results as they arrive, so long suites show progress even in csv/json mode
+class Reporter
+{
+private:
+    std::ostream& m_out;
+    OutputFormat m_format { OutputFormat::text };
+    int m_printed { 0 };
+
+public:
+    Reporter(std::ostream& out, OutputFormat format);
+
+    void begin();
+    void print(const BenchmarkResult& result);
+    void end();
+};
+
+class BenchmarkSuite
+{
+private:
+    std::vector<BenchmarkCase> m_cases { };
+
+public:
+    void add(BenchmarkCase benchmarkCase);
+
+    // Returns the number of cases that failed their check
+    int run(const BenchmarkOptions& options, Reporter& reporter) const;
+};
+
+#endif
@@ -0,0 +1,286 @@
+#ifndef BOUNDEDRANDOM_H
+#define BOUNDEDRANDOM_H
+
+#include "CpuFeatures.h"
+#include "Random.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::int64_t, std::uint32_t, std::uint64_t
+#include <limits>
+#include <random> // for std::uniform_random_bit_generator
+#include <span>
+
+#ifdef CPUFEATURES_X86
+#include <immintrin.h>
+#endif
+
+// Uniform integers in [0, range) with Lemire's multiply-shift ("Fast Random Integer Generation
+// in an Interval", 2019) instead of LCG16's `% 50`: the high half of random32 * range is the
+// result, and the rare products whose low half is below 2^32 % range are redrawn, which makes
+// every result exactly equally likely. The common path has no division at all.
+//
+// With 32 random bits, up to range - 1 of every 2^32 products are redrawn: nothing for small
+// ranges, almost half for range = 2^31 + 1. Large ranges therefore use 64 random bits (from a
+// 64-bit engine, or two 32-bit values) and a 64 x 32-bit product, which all but never redraws.
+
+namespace bounded
+{
+    // 32 random bits from any engine with at least 32-bit output (the high bits of wider ones)
+    template <std::uniform_random_bit_generator Engine>
+    std::uint32_t nextUint32(Engine& engine)
+    {
+        static_assert(Engine::min() == 0 && Engine::max() >= std::numeric_limits<std::uint32_t>::max(),
+            "Engine must produce at least 32 uniform bits");
+
+        const auto value { engine() };
+        if constexpr (Engine::max() > std::numeric_limits<std::uint32_t>::max())
+        {
+            return static_cast<std::uint32_t>(static_cast<std::uint64_t>(value) >> 32);
+        }
+        else
+        {
+            return static_cast<std::uint32_t>(value);
+        }
+    }
+
+    // 64 random bits: a 64-bit engine's output, or two 32-bit ones (low half first)
+    template <std::uniform_random_bit_generator Engine>
+    std::uint64_t nextUint64(Engine& engine)
+    {
+        if constexpr (Engine::max() > std::numeric_limits<std::uint32_t>::max())
+        {
+            static_assert(Engine::min() == 0 && Engine::max() == std::numeric_limits<std::uint64_t>::max(),
+                "Engine must produce 32 or 64 uniform bits");
+            return engine();
+        }
+        else
+        {
+            const std::uint64_t low { nextUint32(engine) };
+            return low | (std::uint64_t { nextUint32(engine) } << 32);
+        }
+    }
+
+    // Above this, fillBounded uses 64 random bits per value: with 32, more than 1 in 256
+    // products would be redrawn
+    inline constexpr std::uint32_t g_narrowRangeLimit { std::uint32_t { 1 } << 24 };
+
+    // 2^32 % range: products with a lower low half belong to an incomplete last round
+    inline std::uint32_t getThreshold(std::uint32_t range)
+    {
+        return static_cast<std::uint32_t>(-range) % range;
+    }
+
+    template <std::uniform_random_bit_generator Engine>
+    std::uint32_t redraw(Engine& engine, std::uint32_t range, std::uint32_t threshold)
+    {
+        std::uint64_t product { };
+        do
+        {
+            product = std::uint64_t { nextUint32(engine) } * range;
+        } while (static_cast<std::uint32_t>(product) < threshold);
+
+        return static_cast<std::uint32_t>(product >> 32);
+    }
+
+    // 2^64 % range, for the 64-bit products
+    inline std::uint64_t getWideThreshold(std::uint32_t range)
+    {
+        return (0 - std::uint64_t { range }) % range;
+    }
+
+#ifdef __SIZEOF_INT128__
+    __extension__ using Uint128 = unsigned __int128;
+#endif
+
+    // The top 32 bits of the 96-bit random * range (one mul with a 128-bit type, two 32 x 32-bit
+    // products without); the low 64 bits go to low
+    inline std::uint32_t multiplyWide(std::uint64_t random, std::uint32_t range, std::uint64_t& low)
+    {
+#ifdef __SIZEOF_INT128__
+        const Uint128 product { Uint128 { random } * range };
+        low = static_cast<std::uint64_t>(product);
+        return static_cast<std::uint32_t>(product >> 64);
+#else
+        const std::uint64_t lowProduct { (random & 0xffffffff) * range };
+        const std::uint64_t middle { (random >> 32) * range + (lowProduct >> 32) };
+        low = (middle << 32) | (lowProduct & 0xffffffff);
+        return static_cast<std::uint32_t>(middle >> 32);
+#endif
+    }
+
+    template <std::uniform_random_bit_generator Engine>
+    std::uint32_t boundedWide(Engine& engine, std::uint32_t range)
+    {
+        std::uint64_t low { };
+        std::uint32_t result { multiplyWide(nextUint64(engine), range, low) };
+        if (low < range) [[unlikely]]
+        {
+            const std::uint64_t threshold { getWideThreshold(range) };
+            while (low < threshold)
+            {
+                result = multiplyWide(nextUint64(engine), range, low);
+            }
+        }
+
+        return result;
+    }
+
+    // fillWide draws the random bits of this many results at a time
+    inline constexpr std::size_t g_wideChunk { 256 };
+
+    // Wide path for a whole span: random bits are drawn in bulk, two values per result
+    template <typename Engine>
+    void fillWide(Engine& engine, std::span<std::uint32_t> values, std::uint32_t range)
+    {
+        std::array<std::uint32_t, 2 * g_wideChunk> random { };
+        const std::uint64_t threshold { getWideThreshold(range) };
+
+        while (!values.empty())
+        {
+            const std::size_t count { std::min(values.size(), g_wideChunk) };
+            engine.fill(std::span { random }.first(2 * count));
+
+            for (std::size_t i { 0 }; i < count; ++i)
+            {
+                std::uint64_t low { };
+                values[i] = multiplyWide(random[2 * i] | (std::uint64_t { random[2 * i + 1] } << 32), range, low);
+                while (low < threshold) [[unlikely]]
+                {
+                    values[i] = multiplyWide(nextUint64(engine), range, low);
+                }
+            }
+
+            values = values.subspan(count);
+        }
+    }
+
+    // values[i] = values[i] * range >> 32 for accepted values, redrawn otherwise
+    template <std::uniform_random_bit_generator Engine>
+    void reduceScalar(Engine& engine, std::span<std::uint32_t> values, std::uint32_t range, std::uint32_t threshold)
+    {
+        for (std::uint32_t& value : values)
+        {
+            const std::uint64_t product { std::uint64_t { value } * range };
+            value = (static_cast<std::uint32_t>(product) < threshold) ? redraw(engine, range, threshold)
+                                                                       : static_cast<std::uint32_t>(product >> 32);
+        }
+    }
+
+#ifdef CPUFEATURES_X86
+    // 8 values per step: vpmuludq multiplies the even lanes, the odd lanes are shifted down and
+    // multiplied separately, and the high / low halves are blended back into lane order
+    template <std::uniform_random_bit_generator Engine>
+    __attribute__((target("avx2"))) void reduceAvx2(Engine& engine, std::span<std::uint32_t> values,
+        std::uint32_t range, std::uint32_t threshold)
+    {
+        const __m256i ranges { _mm256_set1_epi64x(static_cast<long long>(range)) };
+        const __m256i sign { _mm256_set1_epi32(std::numeric_limits<int>::min()) };
+        const __m256i thresholds { _mm256_xor_si256(_mm256_set1_epi32(static_cast<int>(threshold)), sign) };
+
+        std::size_t i { 0 };
+        for (; i + 8 <= values.size(); i += 8)
+        {
+            __m256i* pointer { reinterpret_cast<__m256i*>(values.data() + i) };
+            const __m256i random { _mm256_loadu_si256(pointer) };
+
+            const __m256i even { _mm256_mul_epu32(random, ranges) };
+            const __m256i odd { _mm256_mul_epu32(_mm256_srli_epi64(random, 32), ranges) };
+            const __m256i high { _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0b10101010) };
+            const __m256i low { _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0b10101010) };
+            _mm256_storeu_si256(pointer, high);
+
+            // unsigned low < threshold, as a signed compare with both sign bits flipped
+            const __m256i rejected { _mm256_cmpgt_epi32(thresholds, _mm256_xor_si256(low, sign)) };
+            int mask { _mm256_movemask_ps(_mm256_castsi256_ps(rejected)) };
+            while (mask != 0)
+            {
+                const int lane { __builtin_ctz(static_cast<unsigned>(mask)) };
+                values[i + static_cast<std::size_t>(lane)] = redraw(engine, range, threshold);
+                mask &= mask - 1;
+            }
+        }
+
+        reduceScalar(engine, values.subspan(i), range, threshold);
+    }
+#endif
+}
+
+// One uniform value in [0, range); range must not be 0. 64-bit engines take the wide path.
+template <std::uniform_random_bit_generator Engine>
+std::uint32_t boundedRandom(Engine& engine, std::uint32_t range)
+{
+    assert(range > 0 && "Empty range");
+
+    if constexpr (Engine::max() > std::numeric_limits<std::uint32_t>::max())
+    {
+        return bounded::boundedWide(engine, range);
+    }
+
+    const std::uint64_t product { std::uint64_t { bounded::nextUint32(engine) } * range };
+    if (static_cast<std::uint32_t>(product) < range)
+    {
+        // only now is the threshold (< range) worth its division
+        const std::uint32_t threshold { bounded::getThreshold(range) };
+        if (static_cast<std::uint32_t>(product) < threshold)
+        {
+            return bounded::redraw(engine, range, threshold);
+        }
+    }
+
+    return static_cast<std::uint32_t>(product >> 32);
+}
+
+// Uniform in [min, max], like std::uniform_int_distribution { min, max } (e.g. die3 { 2, 4 } in
+// 07_square_num_game.cpp), without a distribution object
+template <std::uniform_random_bit_generator Engine>
+int uniformInt(Engine& engine, int min, int max)
+{
+    assert(min <= max && "Empty range");
+
+    const auto range { static_cast<std::uint64_t>(std::int64_t { max } - min) + 1 };
+    const std::uint32_t offset { (range > std::numeric_limits<std::uint32_t>::max()) ? bounded::nextUint32(engine)
+                                                                                     : boundedRandom(engine, static_cast<std::uint32_t>(range)) };
+    return static_cast<int>(std::int64_t { min } + offset);
+}
+
+// Fills values with uniform values in [0, range) from an engine with fill(span<uint32_t>): one
+// bulk fill, then one multiply per value (8 at a time with AVX2) and a redraw for the rejected
+// few. The threshold division is paid once per call. Ranges above g_narrowRangeLimit take the
+// (scalar) wide path. Exactly uniform, but not the same values as repeated boundedRandom calls.
+// A kernel the CPU doesn't support falls back to getBestRandomKernel(), as in Xoshiro256x8::fill.
+template <typename Engine>
+void fillBounded(Engine& engine, std::span<std::uint32_t> values, std::uint32_t range,
+    RandomKernel kernel = getBestRandomKernel())
+{
+    assert(range > 0 && "Empty range");
+
+    if (range > bounded::g_narrowRangeLimit)
+    {
+        bounded::fillWide(engine, values, range);
+        return;
+    }
+
+    engine.fill(values);
+    const std::uint32_t threshold { bounded::getThreshold(range) };
+
+    // a forced kernel this CPU lacks would be an illegal instruction
+    if (!isSupported(kernel))
+    {
+        kernel = getBestRandomKernel();
+    }
+
+#ifdef CPUFEATURES_X86
+    if (kernel == RandomKernel::avx2)
+    {
+        bounded::reduceAvx2(engine, values, range, threshold);
+        return;
+    }
+#endif
+    (void)kernel;
+    bounded::reduceScalar(engine, values, range, threshold);
+}
+
+#endif
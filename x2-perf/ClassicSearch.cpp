@@ -0,0 +1,59 @@
+#include "ClassicSearch.h"
+
+int binarySearch(const int* array, int target, int min, int max)
+{
+    while (min <= max)
+    {
+        int center { min + ((max - min) / 2) };
+
+        if (target == array[center])
+        {
+            return center;
+        }
+        else if (target > array[center])
+        {
+            min = center + 1;
+        }
+        else
+        {
+            max = center - 1;
+        }
+    }
+
+    return -1;
+}
+
+int binarySearchRec(const int* array, int target, int min, int max)
+{
+    if (min > max)
+    {
+        return -1;
+    }
+
+    int center { min + ((max - min) / 2) };
+    if (target == array[center])
+    {
+        return center;
+    }
+    else if (target > array[center])
+    {
+        return binarySearchRec(array, target, center + 1, max);
+    }
+    else
+    {
+        return binarySearchRec(array, target, min, center - 1);
+    }
+}
+
+int* findValueLoop(int* arrBegin, int* arrEnd, int value)
+{
+    for (int* i { arrBegin }; i != arrEnd; ++i)
+    {
+        if (*i == value)
+        {
+            return i;
+        }
+    }
+
+    return arrEnd;
+}
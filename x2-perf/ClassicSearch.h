@@ -0,0 +1,13 @@
+#ifndef CLASSICSEARCH_H
+#define CLASSICSEARCH_H
+
+// From 12-functions/ex/08_binary_search.cpp, kept as out-of-line runtime functions (the exercise
+// versions are constexpr now): index of target in array[min..max], or -1 if it is not there
+int binarySearch(const int* array, int target, int min, int max);
+int binarySearchRec(const int* array, int target, int min, int max);
+
+// From 11-arrays-strings-dynamic-allocation/find_value.cpp: findValue, renamed so it doesn't
+// clash with the templated one in FindValue.h. Pointer to the first value in the range, or end.
+int* findValueLoop(int* arrBegin, int* arrEnd, int value);
+
+#endif
@@ -0,0 +1,66 @@
+#include "ClassicSorts.h"
+
+#include <cstddef> // for std::size_t
+#include <utility> // for std::swap
+
+void sortArray(std::span<int> array)
+{
+    if (array.empty())
+    {
+        return;
+    }
+
+    for (std::size_t startIndex { 0 }; startIndex < (array.size() - 1); ++startIndex)
+    {
+        std::size_t smallestIndex { startIndex };
+
+        for (std::size_t currentIndex { startIndex + 1 }; currentIndex < array.size(); ++currentIndex)
+        {
+            if (array[currentIndex] < array[smallestIndex])
+            {
+                smallestIndex = currentIndex;
+            }
+        }
+
+        std::swap(array[startIndex], array[smallestIndex]);
+    }
+}
+
+void selectionSort(int* array, int size, bool (*comparisonFcn)(int, int))
+{
+    for (int startIndex { 0 }; startIndex < (size - 1); ++startIndex)
+    {
+        int bestIndex { startIndex };
+
+        for (int currentIndex { startIndex + 1 }; currentIndex < size; ++currentIndex)
+        {
+            if (comparisonFcn(array[bestIndex], array[currentIndex]))
+            {
+                bestIndex = currentIndex;
+            }
+        }
+
+        std::swap(array[startIndex], array[bestIndex]);
+    }
+}
+
+void bubbleSort(std::span<int> array)
+{
+    for (std::size_t i { 0 }; i + 1 < array.size(); ++i)
+    {
+        bool hasSwapped { false };
+        for (std::size_t j { 0 }; j < array.size() - 1 - i; ++j)
+        {
+            if (array[j] > array[j + 1])
+            {
+                std::swap(array[j], array[j + 1]);
+                hasSwapped = true;
+            }
+        }
+
+        if (!hasSwapped)
+        {
+            break;
+        }
+    }
+}
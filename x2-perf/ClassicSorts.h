@@ -0,0 +1,48 @@
+#ifndef CLASSICSORTS_H
+#define CLASSICSORTS_H
+
+#include <span>
+#include <utility> // for std::swap
+
+// The sorts from the exercises, ported to work on any length so the harness can time them:
+//   sortArray     - 13-basic-oop/ex/03_sort_perf_test.cpp
+//   selectionSort - 12-functions/ex/02_custom_sort_2.cpp
+//   bubbleSort    - 11-arrays-strings-dynamic-allocation/bubble_sort.cpp
+
+// Defined in the header so lambdas wrapping them can be inlined
+inline bool ascending(int x, int y)
+{
+    return x > y;
+}
+
+inline bool descending(int x, int y)
+{
+    return x < y;
+}
+
+void sortArray(std::span<int> array);
+void selectionSort(int* array, int size, bool (*comparisonFcn)(int, int) = ascending);
+void bubbleSort(std::span<int> array);
+
+// Comparator as a template parameter, so lambdas and functors get inlined. Plain function names
+// still go to the function pointer version above (non-template wins a tie).
+template <typename Compare>
+void selectionSort(int* array, int size, Compare comparisonFcn)
+{
+    for (int startIndex { 0 }; startIndex < (size - 1); ++startIndex)
+    {
+        int bestIndex { startIndex };
+
+        for (int currentIndex { startIndex + 1 }; currentIndex < size; ++currentIndex)
+        {
+            if (comparisonFcn(array[bestIndex], array[currentIndex]))
+            {
+                bestIndex = currentIndex;
+            }
+        }
+
+        std::swap(array[startIndex], array[bestIndex]);
+    }
+}
+
+#endif
@@ -0,0 +1,250 @@
+#ifndef CONCURRENTSTACK_H
+#define CONCURRENTSTACK_H
+
+#include <atomic>
+#include <cassert>
+#include <concepts>
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint32_t, std::uint64_t
+#include <limits>
+#include <memory> // for std::unique_ptr
+#include <optional>
+#include <utility> // for std::move
+
+namespace lockfree
+{
+    // A stack head or elimination slot: node index in the low half, a counter in the high half
+    // that changes on every successful CAS, so a head that was popped and pushed back between a
+    // thread's load and its CAS (ABA) no longer compares equal
+    inline constexpr std::uint32_t g_null { std::numeric_limits<std::uint32_t>::max() };
+
+    constexpr std::uint64_t pack(std::uint32_t index, std::uint64_t tag)
+    {
+        return (tag << 32) | index;
+    }
+
+    constexpr std::uint32_t getIndex(std::uint64_t tagged)
+    {
+        return static_cast<std::uint32_t>(tagged);
+    }
+
+    constexpr std::uint64_t getNextTag(std::uint64_t tagged)
+    {
+        return (tagged >> 32) + 1;
+    }
+
+    // xorshift32 per thread, for picking elimination slots
+    inline std::uint32_t nextRandom()
+    {
+        thread_local std::uint32_t state { 0x9e3779b9u ^ static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(&state)) };
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    inline constexpr int g_eliminationSpins { 128 }; // loads a pusher waits for a popper
+}
+
+// Thread-safe Stack for LIFO free lists shared between threads: a Treiber stack (CAS on a
+// tagged head) over a fixed pool of nodes, so push and pop never allocate. Like the Stack in
+// 01_custom_stack.cpp, push returns false once all capacity nodes are in use.
+//
+// With elimination slots, a push and a pop whose CAS on the head failed can meet in a random
+// slot and hand the value over without touching the head, which spreads contention out when
+// many threads hit the stack at once.
+template <typename T>
+    requires std::movable<T> && std::default_initializable<T>
+class ConcurrentStack
+{
+private:
+    struct Node
+    {
+        T value { };
+        std::atomic<std::uint32_t> next { lockfree::g_null };
+    };
+
+    struct alignas(64) Slot
+    {
+        std::atomic<std::uint64_t> tagged { lockfree::pack(lockfree::g_null, 0) };
+    };
+
+    std::unique_ptr<Node[]> m_nodes { };
+    std::unique_ptr<Slot[]> m_slots { };
+    std::size_t m_capacity { };
+    std::uint32_t m_slotCount { };
+
+    // each on its own cache line, so pushes and pops don't also fight over the free list's line
+    alignas(64) std::atomic<std::uint64_t> m_head { lockfree::pack(lockfree::g_null, 0) };
+    alignas(64) std::atomic<std::uint64_t> m_free { lockfree::pack(lockfree::g_null, 0) };
+
+    // One CAS attempt to put node on top of list
+    bool tryLink(std::atomic<std::uint64_t>& list, std::uint32_t node)
+    {
+        std::uint64_t head { list.load(std::memory_order_relaxed) };
+        m_nodes[node].next.store(lockfree::getIndex(head), std::memory_order_relaxed);
+
+        return list.compare_exchange_weak(head, lockfree::pack(node, lockfree::getNextTag(head)),
+            std::memory_order_release, std::memory_order_relaxed);
+    }
+
+    // One CAS attempt to take the top node of list: the node, g_null if the list is empty, or
+    // nullopt if another thread got in between
+    std::optional<std::uint32_t> tryUnlink(std::atomic<std::uint64_t>& list)
+    {
+        std::uint64_t head { list.load(std::memory_order_acquire) };
+        const std::uint32_t node { lockfree::getIndex(head) };
+        if (node == lockfree::g_null)
+        {
+            return lockfree::g_null;
+        }
+
+        // next may be stale if node was popped meanwhile, but then the tag has changed too
+        const std::uint32_t next { m_nodes[node].next.load(std::memory_order_relaxed) };
+        if (list.compare_exchange_weak(head, lockfree::pack(next, lockfree::getNextTag(head)),
+                std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            return node;
+        }
+
+        return std::nullopt;
+    }
+
+    void link(std::atomic<std::uint64_t>& list, std::uint32_t node)
+    {
+        while (!tryLink(list, node))
+        {
+        }
+    }
+
+    std::uint32_t unlink(std::atomic<std::uint64_t>& list)
+    {
+        std::optional<std::uint32_t> node { };
+        while (!(node = tryUnlink(list)))
+        {
+        }
+
+        return *node;
+    }
+
+    Slot& pickSlot()
+    {
+        return m_slots[lockfree::nextRandom() % m_slotCount];
+    }
+
+    // Offers node in a slot for a while; true if a popper took it
+    bool tryEliminatePush(std::uint32_t node)
+    {
+        Slot& slot { pickSlot() };
+        std::uint64_t empty { slot.tagged.load(std::memory_order_relaxed) };
+        if (lockfree::getIndex(empty) != lockfree::g_null)
+        {
+            return false;
+        }
+
+        std::uint64_t offer { lockfree::pack(node, lockfree::getNextTag(empty)) };
+        if (!slot.tagged.compare_exchange_strong(empty, offer, std::memory_order_release, std::memory_order_relaxed))
+        {
+            return false;
+        }
+
+        for (int spin { 0 }; spin < lockfree::g_eliminationSpins; ++spin)
+        {
+            if (slot.tagged.load(std::memory_order_relaxed) != offer)
+            {
+                return true;
+            }
+        }
+
+        // withdraw the offer; only a popper can have changed the slot, so failing means taken
+        return !slot.tagged.compare_exchange_strong(offer, lockfree::pack(lockfree::g_null, lockfree::getNextTag(offer)),
+            std::memory_order_relaxed, std::memory_order_relaxed);
+    }
+
+    // Takes a node a pusher is offering, or g_null
+    std::uint32_t tryEliminatePop()
+    {
+        Slot& slot { pickSlot() };
+        std::uint64_t offer { slot.tagged.load(std::memory_order_acquire) };
+        const std::uint32_t node { lockfree::getIndex(offer) };
+        if (node == lockfree::g_null
+            || !slot.tagged.compare_exchange_strong(offer, lockfree::pack(lockfree::g_null, lockfree::getNextTag(offer)),
+                std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            return lockfree::g_null;
+        }
+
+        return node;
+    }
+
+public:
+    // eliminationSlots = 0 gives a plain Treiber stack
+    explicit ConcurrentStack(std::size_t capacity, std::uint32_t eliminationSlots = 8)
+        : m_nodes { std::make_unique<Node[]>(capacity) }
+        , m_slots { std::make_unique<Slot[]>(eliminationSlots) }
+        , m_capacity { capacity }
+        , m_slotCount { eliminationSlots }
+    {
+        assert(capacity < lockfree::g_null && "Node indexes are 32-bit");
+
+        for (std::size_t i { capacity }; i > 0; --i)
+        {
+            link(m_free, static_cast<std::uint32_t>(i - 1));
+        }
+    }
+
+    ConcurrentStack(const ConcurrentStack&) = delete;
+    ConcurrentStack& operator=(const ConcurrentStack&) = delete;
+
+    bool push(T value)
+    {
+        const std::uint32_t node { unlink(m_free) };
+        if (node == lockfree::g_null)
+        {
+            return false;
+        }
+
+        m_nodes[node].value = std::move(value);
+        while (!tryLink(m_head, node))
+        {
+            if (m_slotCount > 0 && tryEliminatePush(node))
+            {
+                break;
+            }
+        }
+
+        return true;
+    }
+
+    std::optional<T> pop()
+    {
+        std::optional<std::uint32_t> node { };
+        while (!(node = tryUnlink(m_head)))
+        {
+            if (m_slotCount > 0 && (node = tryEliminatePop()) != lockfree::g_null)
+            {
+                break;
+            }
+        }
+
+        if (*node == lockfree::g_null)
+        {
+            return std::nullopt;
+        }
+
+        std::optional<T> value { std::move(m_nodes[*node].value) };
+        link(m_free, *node);
+
+        return value;
+    }
+
+    // Only a snapshot while other threads are pushing or popping
+    bool isEmpty() const
+    {
+        return lockfree::getIndex(m_head.load(std::memory_order_acquire)) == lockfree::g_null;
+    }
+
+    std::size_t getCapacity() const { return m_capacity; }
+};
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef CPUFEATURES_H
+#define CPUFEATURES_H
+
+// Runtime checks for the instruction sets the SIMD kernels are compiled for (with
+// __attribute__((target(...))), so the rest of the program still runs on any x86-64).
+// Always false on other architectures.
+
+#if defined(__x86_64__) || defined(__i386__)
+#define CPUFEATURES_X86
+#endif
+
+inline bool hasSse2()
+{
+#ifdef CPUFEATURES_X86
+    static const bool s_hasSse2 { __builtin_cpu_supports("sse2") != 0 };
+    return s_hasSse2;
+#else
+    return false;
+#endif
+}
+
+inline bool hasSse41()
+{
+#ifdef CPUFEATURES_X86
+    static const bool s_hasSse41 { __builtin_cpu_supports("sse4.1") != 0 };
+    return s_hasSse41;
+#else
+    return false;
+#endif
+}
+
+inline bool hasAvx2()
+{
+#ifdef CPUFEATURES_X86
+    static const bool s_hasAvx2 { __builtin_cpu_supports("avx2") != 0 };
+    return s_hasAvx2;
+#else
+    return false;
+#endif
+}
+
+// AVX-512 F plus BW (byte and word compares); the kernels here need both
+inline bool hasAvx512()
+{
+#ifdef CPUFEATURES_X86
+    static const bool s_hasAvx512 { __builtin_cpu_supports("avx512f") != 0 && __builtin_cpu_supports("avx512bw") != 0 };
+    return s_hasAvx512;
+#else
+    return false;
+#endif
+}
+
+#endif
@@ -0,0 +1,299 @@
+#include "ExternalSort.h"
+#include "StringArena.h"
+#include "StringSort.h"
+#include "TempFile.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint> // for std::uint32_t
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <memory> // for std::unique_ptr
+#include <span>
+#include <stdexcept> // for std::runtime_error
+#include <string>
+#include <string_view>
+#include <utility> // for std::move, std::swap
+#include <vector>
+
+namespace
+{
+    // what stringSort allocates per line: its sort entry and the order index
+    constexpr std::size_t g_sortBytesPerLine { sizeof(strings::Entry) + sizeof(std::uint32_t) };
+
+    // the line array starts this small and doubles, so tiny budgets still hold several lines
+    constexpr std::size_t g_minLineCapacity { 4 };
+
+    // Arena blocks of 1/16 of the budget (64 bytes to 1 MB), so a mostly empty last block is a
+    // small part of it, however small the budget
+    std::size_t getArenaBlockSize(std::size_t memoryBytes)
+    {
+        return std::clamp<std::size_t>(memoryBytes / 16, 64, std::size_t { 1 } << 20);
+    }
+
+    // An ofstream with a big buffer; the buffer has to be set before open() to take effect
+    class BufferedWriter
+    {
+    private:
+        std::vector<char> m_buffer { };
+        std::ofstream m_out { };
+
+    public:
+        BufferedWriter(const std::filesystem::path& path, std::size_t bufferBytes)
+            : m_buffer(bufferBytes)
+        {
+            m_out.rdbuf()->pubsetbuf(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+            m_out.open(path, std::ios::binary);
+
+            if (!m_out)
+            {
+                throw std::runtime_error { "Could not create run file " + path.string() };
+            }
+        }
+
+        std::ostream& getStream() { return m_out; }
+    };
+
+    class RunReader
+    {
+    private:
+        std::vector<char> m_buffer { };
+        std::ifstream m_in { };
+        std::string m_line { };
+        bool m_done { false };
+
+    public:
+        RunReader(const std::filesystem::path& path, std::size_t bufferBytes)
+            : m_buffer(bufferBytes)
+        {
+            m_in.rdbuf()->pubsetbuf(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+            m_in.open(path, std::ios::binary);
+
+            if (!m_in)
+            {
+                throw std::runtime_error { "Could not open run file " + path.string() };
+            }
+
+            advance();
+        }
+
+        void advance()
+        {
+            m_done = !std::getline(m_in, m_line);
+        }
+
+        bool isDone() const { return m_done; }
+        const std::string& getLine() const { return m_line; }
+    };
+
+    // Tournament tree over k sorted sources. m_tree[0] holds the current winner, every other
+    // node the loser of the match played there, so replacing the winner replays only the
+    // log2(k) matches on its path to the root.
+    class LoserTree
+    {
+    private:
+        std::vector<std::unique_ptr<RunReader>>& m_runs;
+        std::vector<std::size_t> m_tree { };
+
+        // exhausted runs lose against everything; ties go to the earlier run (stable)
+        bool beats(std::size_t a, std::size_t b) const
+        {
+            if (m_runs[a]->isDone())
+            {
+                return false;
+            }
+            if (m_runs[b]->isDone())
+            {
+                return true;
+            }
+
+            int order { m_runs[a]->getLine().compare(m_runs[b]->getLine()) };
+            return order < 0 || (order == 0 && a < b);
+        }
+
+        std::size_t build(std::size_t node)
+        {
+            const std::size_t k { m_runs.size() };
+            if (node >= k)
+            {
+                return node - k;
+            }
+
+            std::size_t left { build(2 * node) };
+            std::size_t right { build(2 * node + 1) };
+
+            if (beats(right, left))
+            {
+                std::swap(left, right);
+            }
+
+            m_tree[node] = right;
+            return left;
+        }
+
+    public:
+        explicit LoserTree(std::vector<std::unique_ptr<RunReader>>& runs)
+            : m_runs { runs }, m_tree(runs.size())
+        {
+            assert(!runs.empty() && "Nothing to merge");
+            m_tree[0] = build(1);
+        }
+
+        bool isDone() const { return m_runs[m_tree[0]]->isDone(); }
+        const std::string& getLine() const { return m_runs[m_tree[0]]->getLine(); }
+
+        void pop()
+        {
+            std::size_t winner { m_tree[0] };
+            m_runs[winner]->advance();
+
+            for (std::size_t node { (winner + m_runs.size()) / 2 }; node >= 1; node /= 2)
+            {
+                if (beats(m_tree[node], winner))
+                {
+                    std::swap(m_tree[node], winner);
+                }
+            }
+
+            m_tree[0] = winner;
+        }
+    };
+
+    void mergeRuns(std::span<const TempFile> runs, std::ostream& out, const ExternalSortOptions& options)
+    {
+        std::vector<std::unique_ptr<RunReader>> readers { };
+        for (const auto& run : runs)
+        {
+            readers.push_back(std::make_unique<RunReader>(run.getPath(), options.bufferBytes));
+        }
+
+        LoserTree tree { readers };
+        while (!tree.isDone())
+        {
+            out << tree.getLine() << '\n';
+            tree.pop();
+        }
+    }
+
+    void writeSorted(std::span<std::string_view> lines, std::ostream& out)
+    {
+        stringSort(lines);
+
+        for (std::string_view line : lines)
+        {
+            out << line << '\n';
+        }
+    }
+}
+
+ExternalSortStats externalSortLines(std::istream& in, std::ostream& out, const ExternalSortOptions& options)
+{
+    ExternalSortStats stats { };
+    std::vector<TempFile> runs { };
+
+    StringArena arena { getArenaBlockSize(options.memoryBytes) };
+    std::vector<std::string_view> lines { };
+    std::string line { };
+
+    auto spill {
+        [&]()
+        {
+            TempFile run { options.tempDirectory, "extsort", ".run" };
+            BufferedWriter writer { run.getPath(), options.bufferBytes };
+
+            writeSorted(lines, writer.getStream());
+            if (!writer.getStream().flush())
+            {
+                throw std::runtime_error { "Could not write run file " + run.getPath().string() };
+            }
+
+            runs.push_back(std::move(run));
+            arena.clear();
+            lines.clear(); // keeps its capacity, which stays counted
+        }
+    };
+
+    // Bytes the run would hold with one more line of this size: every arena block, the whole
+    // capacity of lines (grown by doubling here, so the next capacity is known) and the arrays
+    // stringSort allocates per line
+    auto getCapacityAfterPush {
+        [&]()
+        {
+            return (lines.size() < lines.capacity()) ? lines.capacity()
+                                                     : std::max(2 * lines.capacity(), g_minLineCapacity);
+        }
+    };
+
+    auto getRunBytesWith {
+        [&](std::size_t size)
+        {
+            return arena.getAllocatedBytes() + arena.getGrowth(size) + getCapacityAfterPush() * sizeof(std::string_view)
+                + (lines.size() + 1) * g_sortBytesPerLine;
+        }
+    };
+
+    while (std::getline(in, line))
+    {
+        if (getRunBytesWith(line.size()) > options.memoryBytes && !lines.empty())
+        {
+            spill();
+        }
+
+        if (lines.size() == lines.capacity())
+        {
+            lines.reserve(getCapacityAfterPush());
+        }
+
+        lines.push_back(arena.add(line));
+
+        ++stats.lines;
+        stats.bytes += line.size() + 1;
+    }
+
+    // everything fit in memory, no temporary files needed
+    if (runs.empty())
+    {
+        writeSorted(lines, out);
+        stats.runs = lines.empty() ? 0 : 1;
+        return stats;
+    }
+
+    if (!lines.empty())
+    {
+        spill();
+    }
+
+    stats.runs = runs.size();
+
+    // too many runs to merge at once: merge groups of maxFanIn into longer runs first
+    const std::size_t fanIn { std::max<std::size_t>(options.maxFanIn, 2) };
+    while (runs.size() > fanIn)
+    {
+        std::vector<TempFile> merged { };
+
+        for (std::size_t first { 0 }; first < runs.size(); first += fanIn)
+        {
+            std::span<const TempFile> group { runs.data() + first, std::min(fanIn, runs.size() - first) };
+
+            TempFile run { options.tempDirectory, "extsort", ".run" };
+            BufferedWriter writer { run.getPath(), options.bufferBytes };
+            mergeRuns(group, writer.getStream(), options);
+
+            if (!writer.getStream().flush())
+            {
+                throw std::runtime_error { "Could not write run file " + run.getPath().string() };
+            }
+
+            merged.push_back(std::move(run));
+        }
+
+        runs = std::move(merged);
+        ++stats.mergePasses;
+    }
+
+    mergeRuns(runs, out, options);
+    ++stats.mergePasses;
+
+    return stats;
+}
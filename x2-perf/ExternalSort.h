@@ -0,0 +1,41 @@
+#ifndef EXTERNALSORT_H
+#define EXTERNALSORT_H
+
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint64_t
+#include <filesystem>
+#include <iosfwd>
+
+// Sorts a newline-delimited stream that does not fit in memory.
+//
+// 1. Lines are read into a StringArena until memoryBytes is used up, sorted with stringSort
+//    (StringSort.h) and written out as a sorted run to a temporary file.
+// 2. Runs are k-way merged with a loser tree, at most maxFanIn at a time (more runs than that
+//    take extra merge passes). Every run file is read and written sequentially through its own
+//    bufferBytes buffer.
+//
+// memoryBytes bounds everything a run holds: the arena blocks (used or not), the whole capacity of
+// the line array and the arrays stringSort allocates per line. The I/O buffers come on top of it,
+// and a single line longer than the budget still becomes a run of its own.
+//
+// If everything fits in one run, nothing touches the disk. Equal lines keep their input order.
+
+struct ExternalSortOptions
+{
+    std::size_t memoryBytes { std::size_t { 256 } << 20 }; // per in-memory run, see above
+    std::size_t bufferBytes { std::size_t { 1 } << 20 };   // per open run file
+    std::size_t maxFanIn { 64 };
+    std::filesystem::path tempDirectory { std::filesystem::temp_directory_path() };
+};
+
+struct ExternalSortStats
+{
+    std::uint64_t lines { };
+    std::uint64_t bytes { };
+    std::size_t runs { };
+    std::size_t mergePasses { };
+};
+
+ExternalSortStats externalSortLines(std::istream& in, std::ostream& out, const ExternalSortOptions& options);
+
+#endif
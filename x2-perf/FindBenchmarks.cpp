@@ -0,0 +1,314 @@
+#include "ClassicSearch.h"
+#include "FindValue.h"
+#include "MappedFile.h"
+#include "ParallelFind.h"
+#include "Suites.h"
+#include "TempFile.h"
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint> // for std::int8_t, std::int16_t, std::int64_t
+#include <filesystem>
+#include <fstream>
+#include <memory> // for std::shared_ptr, std::unique_ptr
+#include <stdexcept> // for std::runtime_error
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    // Values cycle through 0..99 and the one being looked for (101) is the last element, so every
+    // scan reads the whole array. Only the current size is kept in memory.
+    template <typename T>
+    class FindFixture
+    {
+    private:
+        std::size_t m_size { };
+        bool m_hasData { false };
+
+    public:
+        static constexpr T s_value { static_cast<T>(101) };
+
+        std::vector<T> data { };
+        const T* found { };
+        std::size_t count { };
+        std::vector<std::size_t> positions { };
+
+        void prepare(std::size_t size)
+        {
+            if (m_hasData && m_size == size)
+            {
+                return;
+            }
+
+            data.resize(size);
+            for (std::size_t i { 0 }; i < size; ++i)
+            {
+                data[i] = static_cast<T>(i % 100);
+            }
+
+            if (size > 0)
+            {
+                data.back() = s_value;
+            }
+
+            m_size = size;
+            m_hasData = true;
+        }
+
+        const T* getExpected() const
+        {
+            return data.empty() ? data.data() : data.data() + data.size() - 1;
+        }
+    };
+
+    template <ScanElement T>
+    void addFindTypeCases(BenchmarkSuite& suite, const SuiteOptions& options, std::string_view typeName)
+    {
+        auto fixture { std::make_shared<FindFixture<T>>() };
+        constexpr T value { FindFixture<T>::s_value };
+
+        for (std::size_t size { options.minSize }; size <= options.maxSize; size *= 10)
+        {
+            const std::string group { "find/" + std::string { typeName } + "/" + std::to_string(size) };
+            const auto items { static_cast<double>(size) };
+            const auto bytes { static_cast<double>(size * sizeof(T)) };
+
+            auto setup { [fixture, size]() { fixture->prepare(size); } };
+            auto checkFound { [fixture]() { return fixture->found == fixture->getExpected(); } };
+
+            suite.add({
+                group, "std::find", setup,
+                [fixture, value]() { fixture->found = std::find(fixture->data.data(), fixture->data.data() + fixture->data.size(), value); },
+                checkFound, items, bytes,
+            });
+
+            if constexpr (std::same_as<T, int>)
+            {
+                suite.add({
+                    group, "findValueLoop", setup,
+                    [fixture, value]() { fixture->found = findValueLoop(fixture->data.data(), fixture->data.data() + fixture->data.size(), value); },
+                    checkFound, items, bytes,
+                });
+            }
+
+            for (ScanKernel kernel : { ScanKernel::scalar, ScanKernel::sse2, ScanKernel::avx2, ScanKernel::avx512 })
+            {
+                if (!isSupported(kernel))
+                {
+                    continue;
+                }
+
+                suite.add({
+                    group, "findValue/" + std::string { getScanKernelName(kernel) }, setup,
+                    [fixture, kernel, value]()
+                    {
+                        const T* begin { fixture->data.data() };
+                        fixture->found = findValue(begin, begin + fixture->data.size(), value, kernel);
+                    },
+                    checkFound, items, bytes,
+                });
+            }
+
+            suite.add({
+                group, "countValue", setup,
+                [fixture, value]()
+                {
+                    const T* begin { fixture->data.data() };
+                    fixture->count = countValue(begin, begin + fixture->data.size(), value);
+                },
+                [fixture]() { return fixture->count == (fixture->data.empty() ? 0u : 1u); },
+                items, bytes,
+            });
+
+            suite.add({
+                group, "findAllValues", setup,
+                [fixture, value]()
+                {
+                    const T* begin { fixture->data.data() };
+                    fixture->positions = findAllValues(begin, begin + fixture->data.size(), value);
+                },
+                [fixture]()
+                {
+                    return fixture->data.empty() ? fixture->positions.empty()
+                                                 : fixture->positions == std::vector<std::size_t> { fixture->data.size() - 1 };
+                },
+                items, bytes,
+            });
+
+            if (size == 0)
+            {
+                break;
+            }
+        }
+    }
+}
+
+namespace
+{
+    // The same ints as FindFixture<int>, written to a temporary binary file and mapped. After the
+    // first run the pages are in the page cache and mapped, so this measures the scan, not the disk.
+    //
+    // Two more values occur in many of parallelFindValue's blocks, so only the first match is right:
+    //   s_firstBlockValue - at index 5, at the start of every block from the third on and mid-array
+    //   s_blockEndValue   - at the last index of every block from the second on, so the first
+    //                       match sits right before a block boundary
+    class MappedFindFixture
+    {
+    private:
+        std::size_t m_size { };
+        bool m_hasData { false };
+        std::unique_ptr<MappedFile> m_file { };
+        std::unique_ptr<TempFile> m_path { };
+        std::array<std::size_t, 3> m_firstIndex { }; // of s_value, s_firstBlockValue, s_blockEndValue
+
+        static int getValue(std::size_t i, std::size_t size)
+        {
+            constexpr std::size_t blockSize { g_findBlockBytes / sizeof(int) };
+
+            if (i == size - 1)
+            {
+                return s_value;
+            }
+
+            if (i == 5 || i == size / 2 || (i >= 2 * blockSize && i % blockSize == 0))
+            {
+                return s_firstBlockValue;
+            }
+
+            if (i >= blockSize && i % blockSize == blockSize - 1)
+            {
+                return s_blockEndValue;
+            }
+
+            return static_cast<int>(i % 100);
+        }
+
+    public:
+        static constexpr int s_value { 101 };
+        static constexpr int s_firstBlockValue { 102 };
+        static constexpr int s_blockEndValue { 103 };
+
+        std::span<const int> values { };
+        std::size_t found { };
+
+        void prepare(std::size_t size)
+        {
+            if (m_hasData && m_size == size)
+            {
+                return;
+            }
+
+            values = { };
+            m_file.reset();
+            m_path = std::make_unique<TempFile>(std::filesystem::temp_directory_path(), "findvalue", ".bin");
+
+            {
+                std::ofstream out { m_path->getPath(), std::ios::binary };
+                std::vector<int> block(std::min<std::size_t>(size, std::size_t { 1 } << 20));
+
+                for (std::size_t first { 0 }; first < size; first += block.size())
+                {
+                    std::size_t count { std::min(block.size(), size - first) };
+                    for (std::size_t i { 0 }; i < count; ++i)
+                    {
+                        block[i] = getValue(first + i, size);
+                    }
+
+                    out.write(reinterpret_cast<const char*>(block.data()), static_cast<std::streamsize>(count * sizeof(int)));
+                }
+
+                if (!out)
+                {
+                    throw std::runtime_error { "Can't write " + m_path->getPath().string() };
+                }
+            }
+
+            m_file = std::make_unique<MappedFile>(m_path->getPath());
+            values = m_file->getArray<int>();
+
+            // the reference answers, from a plain std::find over the mapped values
+            for (int value { s_value }; value <= s_blockEndValue; ++value)
+            {
+                m_firstIndex[static_cast<std::size_t>(value - s_value)]
+                    = static_cast<std::size_t>(std::find(values.begin(), values.end(), value) - values.begin());
+            }
+
+            m_size = size;
+            m_hasData = true;
+        }
+
+        bool isFirstMatch(int value) const
+        {
+            return found == m_firstIndex[static_cast<std::size_t>(value - s_value)];
+        }
+    };
+}
+
+void addFindCases(BenchmarkSuite& suite, const SuiteOptions& options)
+{
+    addFindTypeCases<std::int8_t>(suite, options, "int8");
+    addFindTypeCases<std::int16_t>(suite, options, "int16");
+    addFindTypeCases<int>(suite, options, "int");
+    addFindTypeCases<std::int64_t>(suite, options, "int64");
+    addFindTypeCases<float>(suite, options, "float");
+    addFindTypeCases<double>(suite, options, "double");
+}
+
+void addFindMappedCases(BenchmarkSuite& suite, const SuiteOptions& options)
+{
+    auto fixture { std::make_shared<MappedFindFixture>() };
+
+    struct Target
+    {
+        std::string_view name { };
+        int value { };
+    };
+
+    constexpr Target targets[] {
+        { "", MappedFindFixture::s_value },
+        { "first-block/", MappedFindFixture::s_firstBlockValue },
+        { "block-end/", MappedFindFixture::s_blockEndValue },
+    };
+
+    for (const Target& target : targets)
+    {
+        const int value { target.value };
+
+        for (std::size_t size { options.minSize }; size <= options.maxSize; size *= 10)
+        {
+            const std::string group { "find-mapped/" + std::string { target.name } + std::to_string(size) };
+            const auto items { static_cast<double>(size) };
+            const auto bytes { static_cast<double>(size * sizeof(int)) };
+
+            auto setup { [fixture, size]() { fixture->prepare(size); } };
+            auto check { [fixture, value]() { return fixture->isFirstMatch(value); } };
+
+            suite.add({
+                group, "findValue", setup,
+                [fixture, value]()
+                {
+                    const int* begin { fixture->values.data() };
+                    fixture->found = static_cast<std::size_t>(findValue(begin, begin + fixture->values.size(), value) - begin);
+                },
+                check, items, bytes,
+            });
+
+            for (unsigned threads { 1 }; threads <= options.maxThreads; threads *= 2)
+            {
+                suite.add({
+                    group, "parallelFindValue/" + std::to_string(threads) + "t", setup,
+                    [fixture, value, threads]() { fixture->found = parallelFindValue(fixture->values, value, threads); },
+                    check, items, bytes, threads,
+                });
+            }
+
+            if (size == 0)
+            {
+                break;
+            }
+        }
+    }
+}
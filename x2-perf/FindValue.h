@@ -0,0 +1,633 @@
+#ifndef FINDVALUE_H
+#define FINDVALUE_H
+
+#include "CpuFeatures.h"
+
+#include <bit> // for std::bit_cast, std::countr_zero, std::popcount
+#include <concepts>
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint64_t, std::uintptr_t
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#ifdef CPUFEATURES_X86
+#include <immintrin.h>
+#endif
+
+// Linear search with SIMD equality compares, for 8/16/32/64-bit integers, float and double.
+//
+//   findValue     - same contract as findValue in find_value.cpp: pointer to the first element
+//                   equal to value, or end if there is none.
+//   countValue    - how many elements are equal to value.
+//   findAllValues - the positions (offsets from begin) of all of them, in order.
+//
+// Every step compares 64 bytes (4 SSE2, 2 AVX2 or 1 AVX-512 register: 16 ints, 64 chars). The
+// elements before the first aligned address are handled with one unaligned (SSE2/AVX2) or
+// masked (AVX-512) load, so the main loop only does aligned loads, and the tail is either the
+// last whole register with the already-seen lanes masked off or another masked load. Arrays
+// shorter than a register use the scalar loop.
+//
+// Floats compare like ==: NaN never matches and -0.0 matches 0.0.
+//
+// All three take an optional ScanKernel (default getBestScanKernel()). A kernel the CPU doesn't
+// support (isSupported) falls back to getBestScanKernel() rather than failing, so forcing avx512
+// is safe on any machine and gives the same results.
+
+template <typename T>
+concept ScanElement = ((std::integral<T> && !std::same_as<T, bool>) || std::same_as<T, float> || std::same_as<T, double>)
+    && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+enum class ScanKernel
+{
+    scalar,
+    sse2,
+    avx2,
+    avx512,
+};
+
+inline bool isSupported(ScanKernel kernel)
+{
+    switch (kernel)
+    {
+        case ScanKernel::scalar: return true;
+        case ScanKernel::sse2:   return hasSse2();
+        case ScanKernel::avx2:   return hasAvx2();
+        case ScanKernel::avx512: return hasAvx512();
+    }
+
+    return false;
+}
+
+inline ScanKernel getBestScanKernel()
+{
+    static const ScanKernel s_best { hasAvx512() ? ScanKernel::avx512
+        : hasAvx2()                              ? ScanKernel::avx2
+        : hasSse2()                              ? ScanKernel::sse2
+                                                 : ScanKernel::scalar };
+    return s_best;
+}
+
+inline std::string_view getScanKernelName(ScanKernel kernel)
+{
+    switch (kernel)
+    {
+        case ScanKernel::scalar: return "scalar";
+        case ScanKernel::sse2:   return "sse2";
+        case ScanKernel::avx2:   return "avx2";
+        case ScanKernel::avx512: return "avx512";
+    }
+
+    return "???";
+}
+
+namespace scan
+{
+    // Every kernel calls visit(index, lanes) for the blocks that have a match: bit j of lanes
+    // stands for element index + j. visit returns true to stop the scan.
+
+    template <typename T, typename Visit>
+    bool scanScalar(const T* data, std::size_t first, std::size_t last, T value, Visit& visit)
+    {
+        for (std::size_t i { first }; i < last; ++i)
+        {
+            if (data[i] == value && visit(i, std::uint64_t { 1 }))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    constexpr std::uint64_t lowLanes(std::size_t count)
+    {
+        return (count >= 64) ? ~std::uint64_t { 0 } : (std::uint64_t { 1 } << count) - 1;
+    }
+
+    // integers as the signed type of the same size, which is what the set1 intrinsics take
+    template <typename T>
+    auto asSigned(T value)
+    {
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            return value;
+        }
+        else
+        {
+            return std::bit_cast<std::make_signed_t<T>>(value);
+        }
+    }
+
+    // one bit per 16-bit lane from a movemask_epi8 byte mask (both bytes of a lane are equal)
+    constexpr std::uint64_t compressPairs(std::uint32_t bytes)
+    {
+        std::uint32_t mask { bytes & 0x55555555u };
+        mask = (mask | (mask >> 1)) & 0x33333333u;
+        mask = (mask | (mask >> 2)) & 0x0f0f0f0fu;
+        mask = (mask | (mask >> 4)) & 0x00ff00ffu;
+        mask = (mask | (mask >> 8)) & 0x0000ffffu;
+        return mask;
+    }
+
+    // offset (in elements) of the first address aligned to Bytes, at most count
+    template <std::size_t Bytes, typename T>
+    std::size_t alignedStart(const T* data, std::size_t count)
+    {
+        std::size_t misalignment { reinterpret_cast<std::uintptr_t>(data) % Bytes };
+        std::size_t head { (misalignment == 0) ? 0 : (Bytes - misalignment) / sizeof(T) };
+        return (head < count) ? head : count;
+    }
+
+#ifdef CPUFEATURES_X86
+    // SSE2: 16 bytes per register, 4 per step
+
+    template <typename T>
+    __attribute__((target("sse2"))) inline __m128i broadcastSse2(T value)
+    {
+        if constexpr (std::is_same_v<T, float>)
+        {
+            return _mm_castps_si128(_mm_set1_ps(value));
+        }
+        else if constexpr (std::is_same_v<T, double>)
+        {
+            return _mm_castpd_si128(_mm_set1_pd(value));
+        }
+        else if constexpr (sizeof(T) == 1)
+        {
+            return _mm_set1_epi8(asSigned(value));
+        }
+        else if constexpr (sizeof(T) == 2)
+        {
+            return _mm_set1_epi16(asSigned(value));
+        }
+        else if constexpr (sizeof(T) == 4)
+        {
+            return _mm_set1_epi32(asSigned(value));
+        }
+        else
+        {
+            return _mm_set1_epi64x(asSigned(value));
+        }
+    }
+
+    // all ones in the lanes equal to needle
+    template <typename T>
+    __attribute__((target("sse2"))) inline __m128i equalSse2(__m128i block, __m128i needle)
+    {
+        if constexpr (std::is_same_v<T, float>)
+        {
+            return _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(block), _mm_castsi128_ps(needle)));
+        }
+        else if constexpr (std::is_same_v<T, double>)
+        {
+            return _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(block), _mm_castsi128_pd(needle)));
+        }
+        else if constexpr (sizeof(T) == 1)
+        {
+            return _mm_cmpeq_epi8(block, needle);
+        }
+        else if constexpr (sizeof(T) == 2)
+        {
+            return _mm_cmpeq_epi16(block, needle);
+        }
+        else if constexpr (sizeof(T) == 4)
+        {
+            return _mm_cmpeq_epi32(block, needle);
+        }
+        else
+        {
+            // no 64-bit compare before SSE4.1: both 32-bit halves must match
+            __m128i halves { _mm_cmpeq_epi32(block, needle) };
+            return _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+        }
+    }
+
+    template <typename T>
+    __attribute__((target("sse2"))) inline std::uint64_t lanesSse2(__m128i equal)
+    {
+        if constexpr (sizeof(T) == 1)
+        {
+            return static_cast<std::uint32_t>(_mm_movemask_epi8(equal));
+        }
+        else if constexpr (sizeof(T) == 2)
+        {
+            return compressPairs(static_cast<std::uint32_t>(_mm_movemask_epi8(equal)));
+        }
+        else if constexpr (sizeof(T) == 4)
+        {
+            return static_cast<std::uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(equal)));
+        }
+        else
+        {
+            return static_cast<std::uint32_t>(_mm_movemask_pd(_mm_castsi128_pd(equal)));
+        }
+    }
+
+    template <typename T>
+    __attribute__((target("sse2"))) inline __m128i loadSse2(const T* data)
+    {
+        return _mm_load_si128(reinterpret_cast<const __m128i*>(data));
+    }
+
+    template <typename T>
+    __attribute__((target("sse2"))) inline __m128i loadUnalignedSse2(const T* data)
+    {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    }
+
+    template <typename T, typename Visit>
+    __attribute__((target("sse2"))) bool scanSse2(const T* data, std::size_t size, T value, Visit& visit)
+    {
+        constexpr std::size_t lanes { 16 / sizeof(T) };
+        if (size < lanes)
+        {
+            return scanScalar(data, 0, size, value, visit);
+        }
+
+        const __m128i needle { broadcastSse2(value) };
+
+        std::size_t i { alignedStart<16>(data, size) };
+        if (i > 0)
+        {
+            std::uint64_t found { lanesSse2<T>(equalSse2<T>(loadUnalignedSse2(data), needle)) & lowLanes(i) };
+            if (found != 0 && visit(0, found))
+            {
+                return true;
+            }
+        }
+
+        for (; i + 4 * lanes <= size; i += 4 * lanes)
+        {
+            __m128i equal0 { equalSse2<T>(loadSse2(data + i), needle) };
+            __m128i equal1 { equalSse2<T>(loadSse2(data + i + lanes), needle) };
+            __m128i equal2 { equalSse2<T>(loadSse2(data + i + 2 * lanes), needle) };
+            __m128i equal3 { equalSse2<T>(loadSse2(data + i + 3 * lanes), needle) };
+
+            __m128i any { _mm_or_si128(_mm_or_si128(equal0, equal1), _mm_or_si128(equal2, equal3)) };
+            if (_mm_movemask_epi8(any) == 0)
+            {
+                continue;
+            }
+
+            const __m128i equal[] { equal0, equal1, equal2, equal3 };
+            for (std::size_t j { 0 }; j < 4; ++j)
+            {
+                std::uint64_t found { lanesSse2<T>(equal[j]) };
+                if (found != 0 && visit(i + j * lanes, found))
+                {
+                    return true;
+                }
+            }
+        }
+
+        for (; i + lanes <= size; i += lanes)
+        {
+            std::uint64_t found { lanesSse2<T>(equalSse2<T>(loadSse2(data + i), needle)) };
+            if (found != 0 && visit(i, found))
+            {
+                return true;
+            }
+        }
+
+        // tail: the last whole register, minus the lanes already scanned
+        if (i < size)
+        {
+            const std::size_t start { size - lanes };
+            std::uint64_t found { lanesSse2<T>(equalSse2<T>(loadUnalignedSse2(data + start), needle)) & ~lowLanes(i - start) };
+            if (found != 0 && visit(start, found))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // AVX2: 32 bytes per register, 2 per step
+
+    template <typename T>
+    __attribute__((target("avx2"))) inline __m256i broadcastAvx2(T value)
+    {
+        if constexpr (std::is_same_v<T, float>)
+        {
+            return _mm256_castps_si256(_mm256_set1_ps(value));
+        }
+        else if constexpr (std::is_same_v<T, double>)
+        {
+            return _mm256_castpd_si256(_mm256_set1_pd(value));
+        }
+        else if constexpr (sizeof(T) == 1)
+        {
+            return _mm256_set1_epi8(asSigned(value));
+        }
+        else if constexpr (sizeof(T) == 2)
+        {
+            return _mm256_set1_epi16(asSigned(value));
+        }
+        else if constexpr (sizeof(T) == 4)
+        {
+            return _mm256_set1_epi32(asSigned(value));
+        }
+        else
+        {
+            return _mm256_set1_epi64x(asSigned(value));
+        }
+    }
+
+    template <typename T>
+    __attribute__((target("avx2"))) inline __m256i equalAvx2(__m256i block, __m256i needle)
+    {
+        if constexpr (std::is_same_v<T, float>)
+        {
+            return _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(block), _mm256_castsi256_ps(needle), _CMP_EQ_OQ));
+        }
+        else if constexpr (std::is_same_v<T, double>)
+        {
+            return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(block), _mm256_castsi256_pd(needle), _CMP_EQ_OQ));
+        }
+        else if constexpr (sizeof(T) == 1)
+        {
+            return _mm256_cmpeq_epi8(block, needle);
+        }
+        else if constexpr (sizeof(T) == 2)
+        {
+            return _mm256_cmpeq_epi16(block, needle);
+        }
+        else if constexpr (sizeof(T) == 4)
+        {
+            return _mm256_cmpeq_epi32(block, needle);
+        }
+        else
+        {
+            return _mm256_cmpeq_epi64(block, needle);
+        }
+    }
+
+    template <typename T>
+    __attribute__((target("avx2"))) inline std::uint64_t lanesAvx2(__m256i equal)
+    {
+        if constexpr (sizeof(T) == 1)
+        {
+            return static_cast<std::uint32_t>(_mm256_movemask_epi8(equal));
+        }
+        else if constexpr (sizeof(T) == 2)
+        {
+            return compressPairs(static_cast<std::uint32_t>(_mm256_movemask_epi8(equal)));
+        }
+        else if constexpr (sizeof(T) == 4)
+        {
+            return static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(equal)));
+        }
+        else
+        {
+            return static_cast<std::uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(equal)));
+        }
+    }
+
+    template <typename T>
+    __attribute__((target("avx2"))) inline __m256i loadAvx2(const T* data)
+    {
+        return _mm256_load_si256(reinterpret_cast<const __m256i*>(data));
+    }
+
+    template <typename T>
+    __attribute__((target("avx2"))) inline __m256i loadUnalignedAvx2(const T* data)
+    {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+    }
+
+    template <typename T, typename Visit>
+    __attribute__((target("avx2"))) bool scanAvx2(const T* data, std::size_t size, T value, Visit& visit)
+    {
+        constexpr std::size_t lanes { 32 / sizeof(T) };
+        if (size < lanes)
+        {
+            return scanScalar(data, 0, size, value, visit);
+        }
+
+        const __m256i needle { broadcastAvx2(value) };
+
+        std::size_t i { alignedStart<32>(data, size) };
+        if (i > 0)
+        {
+            std::uint64_t found { lanesAvx2<T>(equalAvx2<T>(loadUnalignedAvx2(data), needle)) & lowLanes(i) };
+            if (found != 0 && visit(0, found))
+            {
+                return true;
+            }
+        }
+
+        for (; i + 2 * lanes <= size; i += 2 * lanes)
+        {
+            __m256i equal0 { equalAvx2<T>(loadAvx2(data + i), needle) };
+            __m256i equal1 { equalAvx2<T>(loadAvx2(data + i + lanes), needle) };
+
+            __m256i any { _mm256_or_si256(equal0, equal1) };
+            if (_mm256_testz_si256(any, any))
+            {
+                continue;
+            }
+
+            std::uint64_t found { lanesAvx2<T>(equal0) };
+            if (found != 0 && visit(i, found))
+            {
+                return true;
+            }
+
+            found = lanesAvx2<T>(equal1);
+            if (found != 0 && visit(i + lanes, found))
+            {
+                return true;
+            }
+        }
+
+        for (; i + lanes <= size; i += lanes)
+        {
+            std::uint64_t found { lanesAvx2<T>(equalAvx2<T>(loadAvx2(data + i), needle)) };
+            if (found != 0 && visit(i, found))
+            {
+                return true;
+            }
+        }
+
+        if (i < size)
+        {
+            const std::size_t start { size - lanes };
+            std::uint64_t found { lanesAvx2<T>(equalAvx2<T>(loadUnalignedAvx2(data + start), needle)) & ~lowLanes(i - start) };
+            if (found != 0 && visit(start, found))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // AVX-512: 64 bytes per register, one per step; compares go straight to a lane mask, and the
+    // head and tail are masked loads (masked-off lanes are never read, so nothing can fault)
+
+    template <typename T>
+    __attribute__((target("avx512f,avx512bw"))) inline std::uint64_t compareAvx512(const T* data, std::uint64_t lanes, T value)
+    {
+        if constexpr (std::is_same_v<T, float>)
+        {
+            const auto mask { static_cast<__mmask16>(lanes) };
+            return _mm512_mask_cmp_ps_mask(mask, _mm512_maskz_loadu_ps(mask, data), _mm512_set1_ps(value), _CMP_EQ_OQ);
+        }
+        else if constexpr (std::is_same_v<T, double>)
+        {
+            const auto mask { static_cast<__mmask8>(lanes) };
+            return _mm512_mask_cmp_pd_mask(mask, _mm512_maskz_loadu_pd(mask, data), _mm512_set1_pd(value), _CMP_EQ_OQ);
+        }
+        else if constexpr (sizeof(T) == 1)
+        {
+            const auto mask { static_cast<__mmask64>(lanes) };
+            return _mm512_mask_cmpeq_epi8_mask(mask, _mm512_maskz_loadu_epi8(mask, data), _mm512_set1_epi8(asSigned(value)));
+        }
+        else if constexpr (sizeof(T) == 2)
+        {
+            const auto mask { static_cast<__mmask32>(lanes) };
+            return _mm512_mask_cmpeq_epi16_mask(mask, _mm512_maskz_loadu_epi16(mask, data), _mm512_set1_epi16(asSigned(value)));
+        }
+        else if constexpr (sizeof(T) == 4)
+        {
+            const auto mask { static_cast<__mmask16>(lanes) };
+            return _mm512_mask_cmpeq_epi32_mask(mask, _mm512_maskz_loadu_epi32(mask, data), _mm512_set1_epi32(asSigned(value)));
+        }
+        else
+        {
+            const auto mask { static_cast<__mmask8>(lanes) };
+            return _mm512_mask_cmpeq_epi64_mask(mask, _mm512_maskz_loadu_epi64(mask, data), _mm512_set1_epi64(asSigned(value)));
+        }
+    }
+
+    // lanes is also applied to the result: GCC 12 can leave garbage above bit 7 when a __mmask8
+    // is widened
+    template <typename T>
+    __attribute__((target("avx512f,avx512bw"))) inline std::uint64_t matchesAvx512(const T* data, std::uint64_t lanes, T value)
+    {
+        return compareAvx512(data, lanes, value) & lanes;
+    }
+
+    template <typename T, typename Visit>
+    __attribute__((target("avx512f,avx512bw"))) bool scanAvx512(const T* data, std::size_t size, T value, Visit& visit)
+    {
+        constexpr std::size_t lanes { 64 / sizeof(T) };
+
+        std::size_t i { alignedStart<64>(data, size) };
+        if (i > 0)
+        {
+            std::uint64_t found { matchesAvx512(data, lowLanes(i), value) };
+            if (found != 0 && visit(0, found))
+            {
+                return true;
+            }
+        }
+
+        for (; i + lanes <= size; i += lanes)
+        {
+            std::uint64_t found { matchesAvx512(data + i, lowLanes(lanes), value) };
+            if (found != 0 && visit(i, found))
+            {
+                return true;
+            }
+        }
+
+        if (i < size)
+        {
+            std::uint64_t found { matchesAvx512(data + i, lowLanes(size - i), value) };
+            if (found != 0 && visit(i, found))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+#endif
+
+    template <typename T, typename Visit>
+    void run(const T* data, std::size_t size, T value, ScanKernel kernel, Visit& visit)
+    {
+        // a forced kernel this CPU lacks would be an illegal instruction
+        if (!isSupported(kernel))
+        {
+            kernel = getBestScanKernel();
+        }
+
+#ifdef CPUFEATURES_X86
+        switch (kernel)
+        {
+            case ScanKernel::avx512: scanAvx512(data, size, value, visit); return;
+            case ScanKernel::avx2:   scanAvx2(data, size, value, visit); return;
+            case ScanKernel::sse2:   scanSse2(data, size, value, visit); return;
+            case ScanKernel::scalar: break;
+        }
+#else
+        static_cast<void>(kernel);
+#endif
+
+        scanScalar(data, 0, size, value, visit);
+    }
+}
+
+template <ScanElement T>
+const T* findValue(const T* begin, const T* end, std::type_identity_t<T> value, ScanKernel kernel = getBestScanKernel())
+{
+    const T* found { end };
+    auto visit {
+        [&](std::size_t index, std::uint64_t lanes)
+        {
+            found = begin + index + static_cast<std::size_t>(std::countr_zero(lanes));
+            return true;
+        }
+    };
+
+    scan::run(begin, static_cast<std::size_t>(end - begin), value, kernel, visit);
+    return found;
+}
+
+template <ScanElement T>
+T* findValue(T* begin, T* end, std::type_identity_t<T> value, ScanKernel kernel = getBestScanKernel())
+{
+    return const_cast<T*>(findValue(static_cast<const T*>(begin), static_cast<const T*>(end), value, kernel));
+}
+
+template <ScanElement T>
+std::size_t countValue(const T* begin, const T* end, std::type_identity_t<T> value, ScanKernel kernel = getBestScanKernel())
+{
+    std::size_t count { 0 };
+    auto visit {
+        [&](std::size_t, std::uint64_t lanes)
+        {
+            count += static_cast<std::size_t>(std::popcount(lanes));
+            return false;
+        }
+    };
+
+    scan::run(begin, static_cast<std::size_t>(end - begin), value, kernel, visit);
+    return count;
+}
+
+template <ScanElement T>
+std::vector<std::size_t> findAllValues(const T* begin, const T* end, std::type_identity_t<T> value, ScanKernel kernel = getBestScanKernel())
+{
+    std::vector<std::size_t> positions { };
+    auto visit {
+        [&](std::size_t index, std::uint64_t lanes)
+        {
+            for (; lanes != 0; lanes &= lanes - 1)
+            {
+                positions.push_back(index + static_cast<std::size_t>(std::countr_zero(lanes)));
+            }
+
+            return false;
+        }
+    };
+
+    scan::run(begin, static_cast<std::size_t>(end - begin), value, kernel, visit);
+    return positions;
+}
+
+#endif
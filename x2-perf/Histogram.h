@@ -0,0 +1,286 @@
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+#include "Threads.h"
+
+#include <algorithm>
+#include <bit> // for std::bit_cast, std::countr_zero, std::has_single_bit
+#include <cassert>
+#include <cmath> // for std::exp2, std::log2
+#include <concepts> // for std::integral
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::int64_t, std::uint32_t, std::uint64_t
+#include <limits>
+#include <span>
+#include <vector>
+
+// Histograms of many keys, where prng_histogram.cpp does `occurences[random]++` on one thread.
+//
+// buildHistogram gives each thread private counters for its slice of the keys, padded by a cache
+// line on both sides so the per-key increments never touch a line another thread writes, and
+// sums them at the end. The per-thread totals are padded apart too; only the ends of the bin
+// ranges of the final summing pass can share a line, once per thread.
+//
+// Each thread also keeps g_histogramCopies sub-histograms, and consecutive keys go to different
+// copies: with one array, a run of keys in the same bin makes every increment wait for the
+// previous one's store (the load can only be forwarded from it), while with four the four chains
+// overlap.
+//
+// A bin mapping is any type with getBinCount() and operator()(key) -> bin index:
+//
+//   LinearBins<Key> - binCount bins of equal width from min; integer keys with a power-of-two
+//                     width (like the 50 bins of width 1 in prng_histogram.cpp) only subtract
+//                     and shift.
+//   LogBins<Key>    - binCount bins between min and max whose bounds grow by a constant factor,
+//                     for keys spanning orders of magnitude (latencies, sizes); an approximate
+//                     log2 from the exponent bits instead of std::log2, corrected against a
+//                     table of the bounds.
+//
+// Keys below the first bin count in the first bin and keys past the last bin in the last one.
+
+namespace histogram
+{
+    // log2 of a positive, finite, normal value to within 0.008: the exponent bits, plus
+    // t * (1.3466 - 0.3466 * t) for the mantissa 1 + t
+    inline double approximateLog2(double value)
+    {
+        const auto bits { std::bit_cast<std::uint64_t>(value) };
+        const auto exponent { static_cast<int>((bits >> 52) & 0x7ff) - 1023 };
+        const double t { std::bit_cast<double>((bits & 0x000fffffffffffff) | 0x3ff0000000000000) - 1.0 };
+        return static_cast<double>(exponent) + t * (1.3466 - 0.3466 * t);
+    }
+
+    inline constexpr std::size_t g_histogramCopies { 4 };
+
+    // 32-bit private counters halve the cache footprint; a thread folds them into its 64-bit
+    // totals at least every g_flushKeys keys, before any can overflow
+    inline constexpr std::size_t g_flushKeys { std::numeric_limits<std::uint32_t>::max() };
+
+    // Adds the bins of keys to totals[0 .. binCount), through the g_histogramCopies copies in counts
+    template <typename Key, typename Bins>
+    void countSlice(std::span<const Key> keys, const Bins& bins, std::span<std::uint32_t> counts,
+        std::span<std::uint64_t> totals)
+    {
+        static_assert(g_histogramCopies == 4, "countSlice unrolls over four copies");
+
+        const std::size_t binCount { bins.getBinCount() };
+
+        while (!keys.empty())
+        {
+            const std::span<const Key> chunk { keys.first(std::min(keys.size(), g_flushKeys)) };
+            std::fill(counts.begin(), counts.end(), 0);
+
+            std::uint32_t* const copy0 { counts.data() };
+            std::uint32_t* const copy1 { copy0 + binCount };
+            std::uint32_t* const copy2 { copy1 + binCount };
+            std::uint32_t* const copy3 { copy2 + binCount };
+
+            std::size_t i { 0 };
+            for (; i + g_histogramCopies <= chunk.size(); i += g_histogramCopies)
+            {
+                ++copy0[bins(chunk[i])];
+                ++copy1[bins(chunk[i + 1])];
+                ++copy2[bins(chunk[i + 2])];
+                ++copy3[bins(chunk[i + 3])];
+            }
+
+            for (; i < chunk.size(); ++i)
+            {
+                ++copy0[bins(chunk[i])];
+            }
+
+            for (std::size_t bin { 0 }; bin < binCount; ++bin)
+            {
+                totals[bin] += std::uint64_t { copy0[bin] } + copy1[bin] + copy2[bin] + copy3[bin];
+            }
+
+            keys = keys.subspan(chunk.size());
+        }
+    }
+}
+
+template <typename Key>
+class LinearBins
+{
+private:
+    Key m_min { };
+    std::size_t m_binCount { };
+    double m_scale { };               // floating-point keys: bins per unit
+    std::uint64_t m_width { };        // integer keys
+    int m_shift { -1 };               // integer keys: log2(m_width), or -1 if not a power of two
+
+public:
+    // Bin i holds [min + i * width, min + (i + 1) * width)
+    LinearBins(Key min, Key width, std::size_t binCount)
+        : m_min { min }
+        , m_binCount { binCount }
+    {
+        assert(width > 0 && binCount > 0 && "Empty bins");
+
+        if constexpr (std::integral<Key>)
+        {
+            m_width = static_cast<std::uint64_t>(width);
+            if (std::has_single_bit(m_width))
+            {
+                m_shift = std::countr_zero(m_width);
+            }
+        }
+        else
+        {
+            m_scale = 1.0 / static_cast<double>(width);
+        }
+    }
+
+    std::size_t getBinCount() const { return m_binCount; }
+
+    std::size_t operator()(Key key) const
+    {
+        if constexpr (std::integral<Key>)
+        {
+            if (key < m_min)
+            {
+                return 0;
+            }
+
+            // modulo 2^64, so exact for any key >= m_min, even when key - m_min overflows Key
+            const std::uint64_t offset { static_cast<std::uint64_t>(key) - static_cast<std::uint64_t>(m_min) };
+            const std::uint64_t bin { (m_shift >= 0) ? offset >> m_shift : offset / m_width };
+            return static_cast<std::size_t>(std::min<std::uint64_t>(bin, m_binCount - 1));
+        }
+        else
+        {
+            // !(position >= 0) also sends NaN to the first bin
+            const double position { (static_cast<double>(key) - static_cast<double>(m_min)) * m_scale };
+            if (!(position >= 0.0))
+            {
+                return 0;
+            }
+
+            // through int64: double to int64 is one instruction, double to uint64 is not
+            const auto bin { static_cast<std::int64_t>(std::min(position, static_cast<double>(m_binCount - 1))) };
+            return static_cast<std::size_t>(bin);
+        }
+    }
+};
+
+template <typename Key>
+class LogBins
+{
+private:
+    std::vector<double> m_bounds { }; // binCount + 1: bin i holds [m_bounds[i], m_bounds[i + 1])
+    double m_logMin { };
+    double m_scale { };               // bins per doubling
+
+public:
+    // Bin i holds [min * r^i, min * r^(i + 1)) with r = (max / min)^(1 / binCount)
+    LogBins(Key min, Key max, std::size_t binCount)
+        : m_bounds(binCount + 1)
+        , m_logMin { std::log2(static_cast<double>(min)) }
+        , m_scale { static_cast<double>(binCount) / (std::log2(static_cast<double>(max)) - m_logMin) }
+    {
+        assert(min > 0 && min < max && binCount > 0 && "Log bins need 0 < min < max");
+
+        for (std::size_t i { 0 }; i < binCount; ++i)
+        {
+            m_bounds[i] = std::exp2(m_logMin + static_cast<double>(i) / m_scale);
+        }
+
+        m_bounds.front() = static_cast<double>(min);
+        m_bounds.back() = static_cast<double>(max);
+    }
+
+    std::size_t getBinCount() const { return m_bounds.size() - 1; }
+
+    // The approximate log picks a bin, the bounds (exact, unlike the log) move it at most a step
+    // or two, so it needs no libm call per key
+    std::size_t operator()(Key key) const
+    {
+        const auto value { static_cast<double>(key) };
+        if (!(value >= m_bounds.front())) // also 0, negative keys and NaN
+        {
+            return 0;
+        }
+
+        const std::size_t lastBin { m_bounds.size() - 2 };
+        if (value >= m_bounds.back())
+        {
+            return lastBin;
+        }
+
+        const double position { (histogram::approximateLog2(value) - m_logMin) * m_scale };
+        auto bin { static_cast<std::size_t>(static_cast<std::int64_t>(std::clamp(position, 0.0, static_cast<double>(lastBin)))) };
+
+        // one step either way without branches (the guess is often off by one right at a bound,
+        // unpredictably); more only with hundreds of bins per doubling
+        bin -= static_cast<std::size_t>(value < m_bounds[bin]);
+        bin += static_cast<std::size_t>(value >= m_bounds[bin + 1]);
+        while (value < m_bounds[bin])
+        {
+            --bin;
+        }
+
+        while (value >= m_bounds[bin + 1])
+        {
+            ++bin;
+        }
+
+        return bin;
+    }
+};
+
+// Counts of keys per bin, over threadCount threads. The keys are split into equal slices; each
+// thread counts its own into private sub-histograms, then the per-thread totals are summed, a
+// range of bins per thread.
+template <typename Key, typename Bins>
+std::vector<std::uint64_t> buildHistogram(std::span<const Key> keys, const Bins& bins, unsigned threadCount = 1)
+{
+    assert(threadCount > 0 && "No threads");
+
+    const std::size_t binCount { bins.getBinCount() };
+    std::vector<std::uint64_t> result(binCount);
+
+    if (threadCount == 1)
+    {
+        std::vector<std::uint32_t> counts(histogram::g_histogramCopies * binCount);
+        histogram::countSlice(keys, bins, std::span { counts }, std::span { result });
+        return result;
+    }
+
+    // row per thread, with at least a cache line of padding between rows
+    constexpr std::size_t lineCounts { 64 / sizeof(std::uint64_t) };
+    const std::size_t rowSize { (binCount + lineCounts - 1) / lineCounts * lineCounts + lineCounts };
+    std::vector<std::uint64_t> totals(threadCount * rowSize);
+
+    runOnThreads(threadCount,
+        [&](unsigned thread)
+        {
+            const std::size_t first { keys.size() * thread / threadCount };
+            const std::size_t last { keys.size() * (thread + 1) / threadCount };
+
+            constexpr std::size_t padding { 64 / sizeof(std::uint32_t) };
+            std::vector<std::uint32_t> counts(histogram::g_histogramCopies * binCount + 2 * padding);
+            histogram::countSlice(keys.subspan(first, last - first), bins,
+                std::span { counts }.subspan(padding, histogram::g_histogramCopies * binCount),
+                std::span { totals }.subspan(thread * rowSize, binCount));
+        });
+
+    runOnThreads(threadCount,
+        [&](unsigned thread)
+        {
+            const std::size_t first { binCount * thread / threadCount };
+            const std::size_t last { binCount * (thread + 1) / threadCount };
+
+            for (unsigned row { 0 }; row < threadCount; ++row)
+            {
+                const std::uint64_t* rowTotals { totals.data() + row * rowSize };
+                for (std::size_t bin { first }; bin < last; ++bin)
+                {
+                    result[bin] += rowTotals[bin];
+                }
+            }
+        });
+
+    return result;
+}
+
+#endif
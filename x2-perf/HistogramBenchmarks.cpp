@@ -0,0 +1,261 @@
+#include "BoundedRandom.h"
+#include "Histogram.h"
+#include "Random.h"
+#include "Suites.h"
+
+#include <algorithm>
+#include <cmath> // for std::exp2, std::floor, std::log2
+#include <cstdint> // for std::uint32_t, std::uint64_t
+#include <functional> // for std::function
+#include <limits>
+#include <memory> // for std::shared_ptr
+#include <span>
+#include <string>
+#include <utility> // for std::move
+#include <vector>
+
+namespace
+{
+    // The sequence of prng_histogram.cpp: LCG16() % 50 from its seed 7272
+    void generateLcg16Keys(std::span<int> keys, Xoshiro256&)
+    {
+        unsigned int state { 7272 };
+        for (int& key : keys)
+        {
+            state = 8234233 * state + 2372983;
+            key = static_cast<int>(state % 50);
+        }
+    }
+
+    // Runs of 1 to 64 equal keys in [0, 1024): one counter array serializes on every run
+    void generateRunKeys(std::span<int> keys, Xoshiro256& engine)
+    {
+        std::size_t i { 0 };
+        while (i < keys.size())
+        {
+            const int key { static_cast<int>(boundedRandom(engine, 1024)) };
+            const std::size_t end { std::min(keys.size(), i + 1 + boundedRandom(engine, 64)) };
+            for (; i < end; ++i)
+            {
+                keys[i] = key;
+            }
+        }
+    }
+
+    float getUnitFloat(Xoshiro256& engine)
+    {
+        return static_cast<float>(bounded::nextUint32(engine) >> 8) * 0x1p-24f;
+    }
+
+    // Uniform in [0, 1)
+    void generateUniformKeys(std::span<float> keys, Xoshiro256& engine)
+    {
+        for (float& key : keys)
+        {
+            key = getUnitFloat(engine);
+        }
+    }
+
+    // Log-uniform in [1, 2^20): every doubling equally likely, like latencies
+    void generateLogKeys(std::span<float> keys, Xoshiro256& engine)
+    {
+        for (float& key : keys)
+        {
+            key = std::exp2(20.0f * getUnitFloat(engine));
+        }
+    }
+
+    // The bins of LinearBins and LogBins computed the slow way, to check them against: a division
+    // and std::floor, and a binary search over the bounds. Keys below the first bin (and NaN) go
+    // to the first bin, keys at or past the last bound to the last.
+    std::size_t getLinearBin(double key, double min, double width, std::size_t binCount)
+    {
+        if (!(key >= min))
+        {
+            return 0;
+        }
+
+        return static_cast<std::size_t>(std::min(std::floor((key - min) / width), static_cast<double>(binCount - 1)));
+    }
+
+    std::size_t getLogBin(double key, std::span<const double> bounds)
+    {
+        if (!(key >= bounds.front()))
+        {
+            return 0;
+        }
+
+        const auto bin { static_cast<std::size_t>(std::upper_bound(bounds.begin(), bounds.end(), key) - bounds.begin()) - 1 };
+        return std::min(bin, bounds.size() - 2);
+    }
+
+    // min * r^i for i in [0, binCount], r = (max / min)^(1 / binCount)
+    std::vector<double> getLogBounds(double min, double max, std::size_t binCount)
+    {
+        std::vector<double> bounds(binCount + 1);
+        for (std::size_t i { 0 }; i <= binCount; ++i)
+        {
+            bounds[i] = min * std::exp2(std::log2(max / min) * static_cast<double>(i) / static_cast<double>(binCount));
+        }
+
+        bounds.back() = max;
+        return bounds;
+    }
+
+    // Keys and the reference histogram of the current size are made once per size. The edge keys
+    // (bounds, out of range, NaN) replace generated keys spread over the array.
+    template <typename Key, typename Bins>
+    class HistogramFixture
+    {
+    private:
+        using Generator = void (*)(std::span<Key>, Xoshiro256&);
+
+        Generator m_generate { };
+        std::function<std::size_t(Key)> m_reference { };
+        std::vector<Key> m_edgeKeys { };
+        std::uint64_t m_seed { };
+        std::size_t m_size { };
+        bool m_hasData { false };
+
+    public:
+        Bins bins;
+        std::vector<Key> keys { };
+        std::vector<std::uint64_t> counts { };
+        std::vector<std::uint64_t> expected { };
+
+        HistogramFixture(Bins binMapping, std::function<std::size_t(Key)> reference, std::vector<Key> edgeKeys,
+            Generator generate, std::uint64_t seed)
+            : m_generate { generate }
+            , m_reference { std::move(reference) }
+            , m_edgeKeys { std::move(edgeKeys) }
+            , m_seed { seed }
+            , bins { std::move(binMapping) }
+        {
+        }
+
+        void prepare(std::size_t size)
+        {
+            counts.clear();
+            if (m_hasData && m_size == size)
+            {
+                return;
+            }
+
+            keys.resize(size);
+            Xoshiro256 engine { m_seed };
+            m_generate(keys, engine);
+
+            const std::size_t edgeCount { std::min(m_edgeKeys.size(), size) };
+            for (std::size_t i { 0 }; i < edgeCount; ++i)
+            {
+                keys[i * size / edgeCount] = m_edgeKeys[i];
+            }
+
+            expected.assign(bins.getBinCount(), 0);
+            for (const Key key : keys)
+            {
+                ++expected[m_reference(key)];
+            }
+
+            m_size = size;
+            m_hasData = true;
+        }
+    };
+
+    template <typename Key, typename Bins>
+    void addHistogramGroup(BenchmarkSuite& suite, const SuiteOptions& options, const std::string& name,
+        std::shared_ptr<HistogramFixture<Key, Bins>> fixture)
+    {
+        for (std::size_t size { options.minSize }; size <= options.maxSize; size *= 10)
+        {
+            const std::string group { "histogram/" + name + "/" + std::to_string(size) };
+            const auto items { static_cast<double>(size) };
+            const auto bytes { static_cast<double>(size * sizeof(Key)) };
+            auto setup { [fixture, size]() { fixture->prepare(size); } };
+            auto check { [fixture]() { return fixture->counts == fixture->expected; } };
+
+            // `occurences[random]++` of prng_histogram.cpp: one array, one thread
+            suite.add({
+                group, "one array", setup,
+                [fixture]()
+                {
+                    fixture->counts.assign(fixture->bins.getBinCount(), 0);
+                    for (const Key key : fixture->keys)
+                    {
+                        ++fixture->counts[fixture->bins(key)];
+                    }
+                },
+                check, items, bytes,
+            });
+
+            for (unsigned threads { 1 }; threads <= options.maxThreads; threads *= 2)
+            {
+                suite.add({
+                    group, "buildHistogram/" + std::to_string(threads) + "t", setup,
+                    [fixture, threads]()
+                    {
+                        fixture->counts = buildHistogram(std::span<const Key> { fixture->keys }, fixture->bins, threads);
+                    },
+                    check, items, bytes, threads,
+                });
+            }
+
+            if (size == 0)
+            {
+                break;
+            }
+        }
+    }
+
+    template <typename Key>
+    auto makeLinearFixture(Key min, Key width, std::size_t binCount, std::vector<Key> edgeKeys,
+        void (*generate)(std::span<Key>, Xoshiro256&), std::uint64_t seed)
+    {
+        auto reference {
+            [min, width, binCount](Key key)
+            {
+                return getLinearBin(static_cast<double>(key), static_cast<double>(min), static_cast<double>(width), binCount);
+            }
+        };
+
+        return std::make_shared<HistogramFixture<Key, LinearBins<Key>>>(LinearBins<Key> { min, width, binCount },
+            reference, std::move(edgeKeys), generate, seed);
+    }
+
+    template <typename Key>
+    auto makeLogFixture(Key min, Key max, std::size_t binCount, std::vector<Key> edgeKeys,
+        void (*generate)(std::span<Key>, Xoshiro256&), std::uint64_t seed)
+    {
+        auto reference {
+            [bounds = getLogBounds(static_cast<double>(min), static_cast<double>(max), binCount)](Key key)
+            {
+                return getLogBin(static_cast<double>(key), bounds);
+            }
+        };
+
+        return std::make_shared<HistogramFixture<Key, LogBins<Key>>>(LogBins<Key> { min, max, binCount },
+            reference, std::move(edgeKeys), generate, seed);
+    }
+}
+
+void addHistogramCases(BenchmarkSuite& suite, const SuiteOptions& options)
+{
+    constexpr int intMin { std::numeric_limits<int>::min() };
+    constexpr int intMax { std::numeric_limits<int>::max() };
+    constexpr float infinity { std::numeric_limits<float>::infinity() };
+    constexpr float nan { std::numeric_limits<float>::quiet_NaN() };
+
+    addHistogramGroup(suite, options, "lcg16-50",
+        makeLinearFixture<int>(0, 1, 50, { intMin, -1, 0, 1, 49, 50, intMax }, generateLcg16Keys, options.seed));
+    addHistogramGroup(suite, options, "runs-1024",
+        makeLinearFixture<int>(0, 1, 1024, { intMin, -1, 0, 1023, 1024, intMax }, generateRunKeys, options.seed));
+    addHistogramGroup(suite, options, "float-linear-1000",
+        makeLinearFixture<float>(0.0f, 0.001f, 1000,
+            { -infinity, -0.001f, -0.0f, 0.0f, 0.001f, 0.002f, 0.003f, 0.1f, 0.5f, 0.999f, 1.0f, 2.0f, infinity, nan },
+            generateUniformKeys, options.seed));
+    addHistogramGroup(suite, options, "float-log-80",
+        makeLogFixture<float>(1.0f, 0x1p20f, 80,
+            { -1.0f, 0.0f, 0.5f, 1.0f, 0x1.306fe0p0f, 0x1.fffffep0f, 2.0f, 0x1p10f, 0x1.fffffep19f, 0x1p20f, 0x1p21f,
+                infinity, nan },
+            generateLogKeys, options.seed));
+}
@@ -0,0 +1,116 @@
+#include "InputGenerators.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric> // for std::iota
+#include <random>
+#include <utility> // for std::swap
+
+namespace
+{
+    // Different distributions and sizes get unrelated streams even with the same user seed
+    std::mt19937_64 makeGenerator(Distribution distribution, std::size_t size, std::uint64_t seed)
+    {
+        std::seed_seq ss {
+            static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32),
+            static_cast<std::uint32_t>(distribution),
+            static_cast<std::uint32_t>(size), static_cast<std::uint32_t>(size >> 32),
+        };
+
+        return std::mt19937_64 { ss };
+    }
+
+    // Values beyond INT_MAX wrap, which only happens for sizes nobody can sort anyway
+    int toValue(std::size_t i)
+    {
+        return static_cast<int>(i % static_cast<std::size_t>(std::numeric_limits<int>::max()));
+    }
+}
+
+std::string_view getDistributionName(Distribution distribution)
+{
+    switch (distribution)
+    {
+        case Distribution::sorted:       return "sorted";
+        case Distribution::reversed:     return "reversed";
+        case Distribution::random:       return "random";
+        case Distribution::fewUnique:    return "few-unique";
+        case Distribution::organPipe:    return "organ-pipe";
+        case Distribution::sawtooth:     return "sawtooth";
+        case Distribution::sortedSwaps:  return "sorted-swaps";
+        case Distribution::sortedAppend: return "sorted-append";
+    }
+
+    return "unknown";
+}
+
+std::vector<int> generateInput(Distribution distribution, std::size_t size, std::uint64_t seed,
+    std::size_t swaps)
+{
+    std::vector<int> input(size);
+    auto mt { makeGenerator(distribution, size, seed) };
+
+    switch (distribution)
+    {
+        case Distribution::sorted:
+            std::iota(input.begin(), input.end(), 1);
+            break;
+        case Distribution::reversed:
+            std::iota(input.rbegin(), input.rend(), 1);
+            break;
+        case Distribution::random:
+        {
+            std::uniform_int_distribution<int> die { };
+            std::generate(input.begin(), input.end(), [&]() { return die(mt); });
+            break;
+        }
+        case Distribution::fewUnique:
+        {
+            std::uniform_int_distribution die { 0, g_fewUniqueValues - 1 };
+            std::generate(input.begin(), input.end(), [&]() { return die(mt); });
+            break;
+        }
+        case Distribution::organPipe:
+            for (std::size_t i { 0 }; i < size; ++i)
+            {
+                input[i] = toValue(std::min(i, size - 1 - i));
+            }
+            break;
+        case Distribution::sawtooth:
+        {
+            std::size_t toothLength { size / g_sawtoothTeeth + 1 };
+            for (std::size_t i { 0 }; i < size; ++i)
+            {
+                input[i] = toValue(i % toothLength);
+            }
+            break;
+        }
+        case Distribution::sortedSwaps:
+        {
+            std::iota(input.begin(), input.end(), 1);
+            if (size < 2)
+            {
+                break;
+            }
+
+            std::uniform_int_distribution<std::size_t> die { 0, size - 1 };
+            for (std::size_t i { 0 }; i < swaps; ++i)
+            {
+                std::swap(input[die(mt)], input[die(mt)]);
+            }
+            break;
+        }
+        case Distribution::sortedAppend:
+        {
+            std::size_t batch { size * g_appendPercent / 100 };
+            std::iota(input.begin(), input.end() - static_cast<std::ptrdiff_t>(batch), 1);
+
+            // the batch overlaps the whole key range of the log, like late-arriving records
+            std::uniform_int_distribution die { 1, toValue(size) + 1 };
+            std::generate(input.end() - static_cast<std::ptrdiff_t>(batch), input.end(), [&]() { return die(mt); });
+            break;
+        }
+    }
+
+    return input;
+}
@@ -0,0 +1,42 @@
+#ifndef INPUTGENERATORS_H
+#define INPUTGENERATORS_H
+
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint64_t
+#include <string_view>
+#include <vector>
+
+enum class Distribution
+{
+    sorted,
+    reversed,
+    random,
+    fewUnique,    // only g_fewUniqueValues distinct values
+    organPipe,    // ascending up to the middle, then descending
+    sawtooth,     // g_sawtoothTeeth ascending runs
+    sortedSwaps,  // sorted, then k random pairs swapped
+    sortedAppend, // sorted log with a random batch (g_appendPercent of the size) appended
+};
+
+inline constexpr Distribution g_distributions[] {
+    Distribution::sorted,
+    Distribution::reversed,
+    Distribution::random,
+    Distribution::fewUnique,
+    Distribution::organPipe,
+    Distribution::sawtooth,
+    Distribution::sortedSwaps,
+    Distribution::sortedAppend,
+};
+
+inline constexpr int g_fewUniqueValues { 16 };
+inline constexpr std::size_t g_sawtoothTeeth { 32 };
+inline constexpr std::size_t g_appendPercent { 1 };
+
+std::string_view getDistributionName(Distribution distribution);
+
+// Same (distribution, size, seed, swaps) always gives the same input
+std::vector<int> generateInput(Distribution distribution, std::size_t size, std::uint64_t seed,
+    std::size_t swaps = 16);
+
+#endif
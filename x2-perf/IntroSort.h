@@ -0,0 +1,100 @@
+#ifndef INTROSORT_H
+#define INTROSORT_H
+
+#include "SortingNetworks.h"
+
+#include <algorithm>
+#include <bit> // for std::bit_width
+#include <cstddef> // for std::size_t
+#include <span>
+#include <utility> // for std::swap
+
+// Quicksort (median of three, Hoare partition) that switches to heapsort when recursion gets
+// too deep, like std::sort. Partitions of up to g_maxNetworkSize elements are finished with a
+// branchless sorting network instead of insertion sort.
+
+namespace intro
+{
+    template <typename T>
+    void sortRange(T* first, T* last, int depthLimit)
+    {
+        while (static_cast<std::size_t>(last - first) > g_maxNetworkSize)
+        {
+            if (depthLimit == 0)
+            {
+                std::make_heap(first, last);
+                std::sort_heap(first, last);
+                return;
+            }
+            --depthLimit;
+
+            // after this *first <= *middle <= *(last - 1), which keeps both scans below in bounds
+            T* middle { first + (last - first) / 2 };
+            if (*middle < *first)
+            {
+                std::swap(*middle, *first);
+            }
+            if (*(last - 1) < *middle)
+            {
+                std::swap(*(last - 1), *middle);
+                if (*middle < *first)
+                {
+                    std::swap(*middle, *first);
+                }
+            }
+
+            const T pivot { *middle };
+            T* left { first };
+            T* right { last - 1 };
+
+            while (true)
+            {
+                while (*left < pivot)
+                {
+                    ++left;
+                }
+                while (pivot < *right)
+                {
+                    --right;
+                }
+
+                if (left >= right)
+                {
+                    break;
+                }
+
+                std::swap(*left, *right);
+                ++left;
+                --right;
+            }
+
+            // [first, right] <= pivot <= (right, last); recurse into the smaller side
+            T* cut { right + 1 };
+            if (cut - first < last - cut)
+            {
+                sortRange(first, cut, depthLimit);
+                first = cut;
+            }
+            else
+            {
+                sortRange(cut, last, depthLimit);
+                last = cut;
+            }
+        }
+
+        sortSmall(first, static_cast<std::size_t>(last - first));
+    }
+}
+
+template <typename T>
+void introSort(std::span<T> array)
+{
+    if (array.empty())
+    {
+        return;
+    }
+
+    intro::sortRange(array.data(), array.data() + array.size(), 2 * static_cast<int>(std::bit_width(array.size())));
+}
+
+#endif
@@ -0,0 +1,142 @@
+#include "LearnedIndex.h"
+
+#include "Search.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+namespace
+{
+    // index of the first of the size keys at first that is >= target (size if none), see
+    // branchlessSearch
+    int branchlessLowerBound(const int* first, int size, int target)
+    {
+        if (size <= 0)
+        {
+            return 0;
+        }
+
+        const int* base { first };
+        int length { size };
+        while (length > 1)
+        {
+            int half { length / 2 };
+            base = (base[half] < target) ? base + half : base;
+            length -= half;
+        }
+
+        return static_cast<int>(base - first) + (*base < target);
+    }
+}
+
+LearnedIndex::LearnedIndex(std::span<const int> sorted, int errorBound)
+    : m_keys { sorted }, m_errorBound { errorBound }
+{
+    assert(std::is_sorted(sorted.begin(), sorted.end()) && "Learned index needs sorted keys");
+    assert(errorBound >= 0 && "The error bound can't be negative");
+
+    const std::size_t size { sorted.size() };
+    const double error { static_cast<double>(errorBound) };
+
+    // Each segment starts exactly on its first key and keeps the range of slopes that put every
+    // key so far within the error bound; a key that empties the range starts the next segment.
+    // Duplicates are fitted at their first position.
+    std::size_t start { 0 };
+    while (start < size)
+    {
+        const double startKey { static_cast<double>(sorted[start]) };
+        double slopeLow { 0.0 };
+        double slopeHigh { std::numeric_limits<double>::infinity() };
+
+        std::size_t next { start + 1 };
+        for (; next < size; ++next)
+        {
+            if (sorted[next] == sorted[next - 1])
+            {
+                continue;
+            }
+
+            double dx { static_cast<double>(sorted[next]) - startKey };
+            double dy { static_cast<double>(next - start) };
+            double low { std::max(slopeLow, (dy - error) / dx) };
+            double high { std::min(slopeHigh, (dy + error) / dx) };
+
+            if (low > high)
+            {
+                break;
+            }
+
+            slopeLow = low;
+            slopeHigh = high;
+        }
+
+        double slope { (slopeHigh == std::numeric_limits<double>::infinity()) ? slopeLow : (slopeLow + slopeHigh) / 2 };
+
+        m_segmentKeys.push_back(sorted[start]);
+        m_segments.push_back({ slope, static_cast<int>(start), static_cast<int>(next) });
+        start = next;
+    }
+
+    // model lookup ~ log2(segments) + log2(window) probes vs. log2(size) for a binary search;
+    // keep the model only if it saves at least two probes to pay for the prediction
+    const std::size_t window { 2 * static_cast<std::size_t>(errorBound) + 3 };
+    m_useModel = !m_segments.empty() && 4 * m_segments.size() * window < size;
+}
+
+int LearnedIndex::lowerBoundModel(int target) const
+{
+    // the last segment starting at or before target
+    const int next { branchlessLowerBound(m_segmentKeys.data(), static_cast<int>(m_segmentKeys.size()), target) };
+    const bool exact { next < static_cast<int>(m_segmentKeys.size()) && m_segmentKeys[static_cast<std::size_t>(next)] == target };
+    if (next == 0 && !exact)
+    {
+        return 0;
+    }
+
+    const auto index { static_cast<std::size_t>(exact ? next : next - 1) };
+    const Segment& segment { m_segments[index] };
+    const double offset { segment.slope * (static_cast<double>(target) - static_cast<double>(m_segmentKeys[index])) };
+
+    // keys between two fitted ones land between their predictions; past the last key of the
+    // segment, the answer is its end
+    const int predicted { segment.first + static_cast<int>(std::min(offset, static_cast<double>(segment.end - segment.first))) };
+
+    const int size { static_cast<int>(m_keys.size()) };
+    const int low { std::max(predicted - m_errorBound - 1, 0) };
+    const int high { std::min(predicted + m_errorBound + 2, size) };
+
+    const int position { low + branchlessLowerBound(m_keys.data() + low, high - low, target) };
+
+    // the bound holds for the first copy of each key; a long run of duplicates can still push
+    // the answer out of the window, so check both edges
+    if ((position == low && low > 0 && m_keys[static_cast<std::size_t>(low - 1)] >= target)
+        || (position == high && high < size))
+    {
+        return branchlessLowerBound(m_keys.data(), size, target);
+    }
+
+    return position;
+}
+
+int LearnedIndex::lowerBound(int target) const
+{
+    if (m_useModel)
+    {
+        return lowerBoundModel(target);
+    }
+
+    return branchlessLowerBound(m_keys.data(), static_cast<int>(m_keys.size()), target);
+}
+
+int LearnedIndex::find(int target) const
+{
+    if (!m_useModel)
+    {
+        return branchlessSearch(m_keys.data(), static_cast<int>(m_keys.size()), target);
+    }
+
+    int position { lowerBoundModel(target) };
+
+    return (position != static_cast<int>(m_keys.size()) && m_keys[static_cast<std::size_t>(position)] == target) ? position : -1;
+}
@@ -0,0 +1,53 @@
+#ifndef LEARNEDINDEX_H
+#define LEARNEDINDEX_H
+
+#include <cstddef> // for std::size_t
+#include <span>
+#include <vector>
+
+inline constexpr int g_learnedDefaultError { 32 };
+
+// Opt-in search mode for roughly uniform keys (ID tables, the array in 08_binary_search.cpp).
+//
+// The index fits a piecewise-linear model key -> position over the sorted keys (greedy
+// shrinking-cone segments, like a single level of a PGM index): every key's predicted position
+// is within getErrorBound() of its real one. A lookup finds the key's segment, predicts, and
+// corrects with a binary search over the 2 * error + 3 keys around the prediction.
+//
+// On adversarial data (big jumps everywhere) the model needs so many segments that searching
+// them costs as much as a plain binary search; then usesModel() is false and every lookup is a
+// branchless binary search over the keys.
+//
+// Only the model is stored; the keys stay where they are and must outlive the index.
+class LearnedIndex
+{
+private:
+    std::span<const int> m_keys { };
+    int m_errorBound { };
+    bool m_useModel { };
+
+    struct Segment
+    {
+        double slope { };
+        int first { }; // position of the segment's first key
+        int end { };   // one past its last key
+    };
+
+    std::vector<int> m_segmentKeys { }; // first key of every segment
+    std::vector<Segment> m_segments { };
+
+    int lowerBoundModel(int target) const;
+
+public:
+    explicit LearnedIndex(std::span<const int> sorted, int errorBound = g_learnedDefaultError);
+
+    int find(int target) const;
+    int lowerBound(int target) const; // index of the first key >= target, or size
+
+    int getErrorBound() const { return m_errorBound; }
+    bool usesModel() const { return m_useModel; }
+    int getSegmentCount() const { return static_cast<int>(m_segments.size()); }
+    std::size_t getMemoryBytes() const { return m_segmentKeys.size() * sizeof(int) + m_segments.size() * sizeof(Segment); }
+};
+
+#endif
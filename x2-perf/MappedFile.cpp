@@ -0,0 +1,78 @@
+#include "MappedFile.h"
+
+#include <cerrno>
+#include <cstring> // for std::strerror
+#include <stdexcept> // for std::runtime_error
+#include <string>
+#include <utility> // for std::swap
+
+#include <fcntl.h> // for open
+#include <sys/mman.h> // for mmap, munmap, madvise
+#include <sys/stat.h> // for fstat
+#include <unistd.h> // for close
+
+namespace
+{
+    [[noreturn]] void fail(const std::string& what, const std::filesystem::path& path)
+    {
+        throw std::runtime_error { what + " " + path.string() + ": " + std::strerror(errno) };
+    }
+}
+
+MappedFile::MappedFile(const std::filesystem::path& path)
+{
+    int descriptor { ::open(path.c_str(), O_RDONLY) };
+    if (descriptor < 0)
+    {
+        fail("Can't open", path);
+    }
+
+    struct stat status { };
+    if (::fstat(descriptor, &status) != 0)
+    {
+        ::close(descriptor);
+        fail("Can't stat", path);
+    }
+
+    m_size = static_cast<std::size_t>(status.st_size);
+
+    // mmap refuses empty mappings; an empty file is just an empty span
+    if (m_size > 0)
+    {
+        void* address { ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, descriptor, 0) };
+        if (address == MAP_FAILED)
+        {
+            ::close(descriptor);
+            fail("Can't map", path);
+        }
+
+        // scans read front to back, so let the kernel read ahead aggressively
+        ::madvise(address, m_size, MADV_SEQUENTIAL);
+        m_data = static_cast<const std::byte*>(address);
+    }
+
+    // the mapping keeps the file alive on its own
+    ::close(descriptor);
+}
+
+MappedFile::~MappedFile()
+{
+    if (m_data)
+    {
+        ::munmap(const_cast<std::byte*>(m_data), m_size);
+    }
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : m_data { other.m_data }, m_size { other.m_size }
+{
+    other.m_data = nullptr;
+    other.m_size = 0;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    std::swap(m_data, other.m_data);
+    std::swap(m_size, other.m_size);
+    return *this;
+}
@@ -0,0 +1,37 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef> // for std::byte, std::size_t
+#include <filesystem>
+#include <span>
+
+// A whole file mapped read-only into memory (POSIX mmap), unmapped on destruction. Pages are
+// read from disk (or the page cache) on first touch, so a scan that stops early never reads the
+// rest of the file. Throws std::runtime_error if the file can't be opened or mapped.
+class MappedFile
+{
+private:
+    const std::byte* m_data { nullptr };
+    std::size_t m_size { 0 };
+
+public:
+    explicit MappedFile(const std::filesystem::path& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    std::span<const std::byte> getBytes() const { return { m_data, m_size }; }
+
+    // the file as an array of T; trailing bytes that don't make a whole T are left out
+    template <typename T>
+    std::span<const T> getArray() const
+    {
+        return { reinterpret_cast<const T*>(m_data), m_size / sizeof(T) };
+    }
+};
+
+#endif
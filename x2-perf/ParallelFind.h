@@ -0,0 +1,68 @@
+#ifndef PARALLELFIND_H
+#define PARALLELFIND_H
+
+#include "FindValue.h"
+#include "Threads.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef> // for std::size_t
+#include <span>
+#include <type_traits> // for std::type_identity_t
+
+// Blocks the threads take turns on; big enough that handing them out costs nothing, small
+// enough that a match near the front stops the other threads quickly
+inline constexpr std::size_t g_findBlockBytes { std::size_t { 1 } << 20 };
+
+// findValue split over threadCount threads, typically over a MappedFile. Returns the index of
+// the first element equal to value, or values.size() - the same answer as findValue.
+//
+// Threads grab blocks in increasing order from a shared counter and scan them with findValue.
+// A match lowers the shared "first found" index; a thread stops as soon as the next block
+// starts at or after it, so nothing past the first match is scanned once it is known, while
+// every block before it is still scanned in full.
+template <ScanElement T>
+std::size_t parallelFindValue(std::span<const T> values, std::type_identity_t<T> value, unsigned threadCount)
+{
+    const std::size_t blockSize { g_findBlockBytes / sizeof(T) };
+    const std::size_t blocks { (values.size() + blockSize - 1) / blockSize };
+
+    std::atomic<std::size_t> nextBlock { 0 };
+    std::atomic<std::size_t> firstFound { values.size() };
+
+    threadCount = std::max(1u, std::min<unsigned>(threadCount, static_cast<unsigned>(std::max<std::size_t>(blocks, 1))));
+
+    runOnThreads(threadCount,
+        [&](unsigned)
+        {
+            for (std::size_t block { nextBlock.fetch_add(1, std::memory_order_relaxed) }; block < blocks;
+                 block = nextBlock.fetch_add(1, std::memory_order_relaxed))
+            {
+                const std::size_t begin { block * blockSize };
+                if (begin >= firstFound.load(std::memory_order_relaxed))
+                {
+                    return;
+                }
+
+                const std::size_t end { std::min(begin + blockSize, values.size()) };
+                const T* found { findValue(values.data() + begin, values.data() + end, value) };
+                if (found == values.data() + end)
+                {
+                    continue;
+                }
+
+                // keep the smallest index any thread found
+                std::size_t index { static_cast<std::size_t>(found - values.data()) };
+                std::size_t current { firstFound.load(std::memory_order_relaxed) };
+                while (index < current && !firstFound.compare_exchange_weak(current, index, std::memory_order_relaxed))
+                {
+                }
+
+                return;
+            }
+        });
+
+    return firstFound.load();
+}
+
+#endif
@@ -0,0 +1,179 @@
+#ifndef PARALLELSORT_H
+#define PARALLELSORT_H
+
+#include "Threads.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef> // for std::size_t
+#include <functional> // for std::less
+#include <span>
+#include <utility> // for std::move
+#include <vector>
+
+// Parallel sample sort:
+//
+// 1. the input is split into threadCount chunks which are sorted concurrently with std::sort,
+// 2. threadCount - 1 splitters are picked from regular samples of the sorted chunks,
+// 3. each thread merges "its" key range out of every chunk into the scratch buffer (k-way merge),
+// 4. once all merges are done, each thread copies its finished range back.
+//
+// Scratch is exactly one buffer of array.size() elements; pass one in to reuse it across calls.
+// With many duplicate keys the key ranges can get uneven, which costs speed but not correctness.
+
+namespace parallel
+{
+    inline constexpr std::size_t g_minChunk { 1 << 14 }; // smaller chunks are not worth a thread
+
+    // Merges the sorted runs [begins[i], ends[i]) into out
+    template <typename T, typename Compare>
+    void multiwayMerge(std::vector<const T*> begins, std::vector<const T*> ends, T* out, Compare comp)
+    {
+        std::vector<std::size_t> heap { };
+        for (std::size_t i { 0 }; i < begins.size(); ++i)
+        {
+            if (begins[i] != ends[i])
+            {
+                heap.push_back(i);
+            }
+        }
+
+        // min-heap on the current head of every run
+        auto heapComp {
+            [&begins, &comp](std::size_t a, std::size_t b)
+            {
+                return comp(*begins[b], *begins[a]);
+            }
+        };
+
+        std::make_heap(heap.begin(), heap.end(), heapComp);
+
+        while (heap.size() > 1)
+        {
+            std::pop_heap(heap.begin(), heap.end(), heapComp);
+            std::size_t run { heap.back() };
+
+            *out++ = *begins[run]++;
+
+            if (begins[run] == ends[run])
+            {
+                heap.pop_back();
+            }
+            else
+            {
+                std::push_heap(heap.begin(), heap.end(), heapComp);
+            }
+        }
+
+        if (!heap.empty())
+        {
+            std::copy(begins[heap.front()], ends[heap.front()], out);
+        }
+    }
+}
+
+template <typename T, typename Compare = std::less<>>
+void parallelSort(std::span<T> array, std::span<T> scratch, unsigned threadCount, Compare comp = Compare { })
+{
+    assert(scratch.size() >= array.size() && "Parallel sort scratch buffer is too small");
+
+    const std::size_t size { array.size() };
+    const auto parts { static_cast<std::size_t>(
+        std::clamp<std::size_t>(size / parallel::g_minChunk, 1, std::max(1u, threadCount))) };
+
+    if (parts == 1)
+    {
+        std::sort(array.begin(), array.end(), comp);
+        return;
+    }
+
+    auto chunkBegin { [size, parts](std::size_t chunk) { return size * chunk / parts; } };
+
+    runOnThreads(static_cast<unsigned>(parts),
+        [&](unsigned chunk)
+        {
+            std::sort(array.begin() + static_cast<std::ptrdiff_t>(chunkBegin(chunk)),
+                array.begin() + static_cast<std::ptrdiff_t>(chunkBegin(chunk + 1)), comp);
+        });
+
+    // parts samples from every chunk, every parts-th of them (sorted) becomes a splitter
+    std::vector<T> samples { };
+    samples.reserve(parts * parts);
+    for (std::size_t chunk { 0 }; chunk < parts; ++chunk)
+    {
+        std::size_t begin { chunkBegin(chunk) };
+        std::size_t length { chunkBegin(chunk + 1) - begin };
+
+        for (std::size_t s { 0 }; s < parts; ++s)
+        {
+            samples.push_back(array[begin + length * s / parts]);
+        }
+    }
+    std::sort(samples.begin(), samples.end(), comp);
+
+    // split[chunk * (parts + 1) + range] = where key range "range" starts inside chunk
+    std::vector<std::size_t> split((parts + 1) * parts);
+    for (std::size_t chunk { 0 }; chunk < parts; ++chunk)
+    {
+        auto first { array.begin() + static_cast<std::ptrdiff_t>(chunkBegin(chunk)) };
+        auto last { array.begin() + static_cast<std::ptrdiff_t>(chunkBegin(chunk + 1)) };
+
+        split[chunk * (parts + 1)] = chunkBegin(chunk);
+        for (std::size_t range { 1 }; range < parts; ++range)
+        {
+            auto position { std::lower_bound(first, last, samples[range * parts], comp) };
+            split[chunk * (parts + 1) + range] = static_cast<std::size_t>(position - array.begin());
+            first = position;
+        }
+        split[chunk * (parts + 1) + parts] = chunkBegin(chunk + 1);
+    }
+
+    // output offset of every key range
+    std::vector<std::size_t> offsets(parts + 1);
+    for (std::size_t range { 0 }; range < parts; ++range)
+    {
+        std::size_t length { 0 };
+        for (std::size_t chunk { 0 }; chunk < parts; ++chunk)
+        {
+            length += split[chunk * (parts + 1) + range + 1] - split[chunk * (parts + 1) + range];
+        }
+        offsets[range + 1] = offsets[range] + length;
+    }
+
+    runOnThreads(static_cast<unsigned>(parts),
+        [&](unsigned range)
+        {
+            std::vector<const T*> begins(parts);
+            std::vector<const T*> ends(parts);
+            for (std::size_t chunk { 0 }; chunk < parts; ++chunk)
+            {
+                begins[chunk] = array.data() + split[chunk * (parts + 1) + range];
+                ends[chunk] = array.data() + split[chunk * (parts + 1) + range + 1];
+            }
+
+            parallel::multiwayMerge(std::move(begins), std::move(ends), scratch.data() + offsets[range], comp);
+        });
+
+    // separate step, the merges above still read from every chunk of array
+    runOnThreads(static_cast<unsigned>(parts),
+        [&](unsigned range)
+        {
+            std::copy(scratch.data() + offsets[range], scratch.data() + offsets[range + 1],
+                array.data() + offsets[range]);
+        });
+}
+
+template <typename T, typename Compare = std::less<>>
+void parallelSort(std::span<T> array, unsigned threadCount, Compare comp = Compare { })
+{
+    if (array.size() < 2 * parallel::g_minChunk || threadCount <= 1)
+    {
+        std::sort(array.begin(), array.end(), comp);
+        return;
+    }
+
+    std::vector<T> scratch(array.size());
+    parallelSort(array, std::span<T> { scratch }, threadCount, comp);
+}
+
+#endif
@@ -0,0 +1,302 @@
+#ifndef PHILOX_H
+#define PHILOX_H
+
+#include "CpuFeatures.h"
+#include "Random.h"
+#include "Threads.h"
+
+#include <algorithm>
+#include <array>
+#include <concepts> // for std::uniform_random_bit_generator
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint32_t, std::uint64_t
+#include <limits>
+#include <span>
+
+#ifdef CPUFEATURES_X86
+#include <immintrin.h>
+#endif
+
+// Philox4x32-10 (Salmon, Moraes, Dror, Shaw, "Parallel Random Numbers: As Easy as 1, 2, 3",
+// 2011): a counter-based generator. Value number i of stream (seed, stream) is a pure function
+// of (seed, stream, i): ten rounds of multiply / xor on a 128-bit block { i / 4, stream } with
+// the seed as key, giving four 32-bit values per block.
+//
+// So any thread can start anywhere in O(1): give every simulation item its own stream, or split
+// one stream into slices, and the values are bit-identical for any thread count. The engine's
+// whole state is the seed, stream and position (plus the current block).
+
+namespace philox
+{
+    using Block = std::array<std::uint32_t, 4>;
+
+    inline void mulHiLo(std::uint32_t a, std::uint32_t b, std::uint32_t& high, std::uint32_t& low)
+    {
+        const std::uint64_t product { std::uint64_t { a } * b };
+        high = static_cast<std::uint32_t>(product >> 32);
+        low = static_cast<std::uint32_t>(product);
+    }
+
+    // The block for counter words { counter low, counter high, stream low, stream high }
+    inline Block generate(std::uint64_t seed, std::uint64_t stream, std::uint64_t counter)
+    {
+        std::uint32_t c0 { static_cast<std::uint32_t>(counter) };
+        std::uint32_t c1 { static_cast<std::uint32_t>(counter >> 32) };
+        std::uint32_t c2 { static_cast<std::uint32_t>(stream) };
+        std::uint32_t c3 { static_cast<std::uint32_t>(stream >> 32) };
+        std::uint32_t k0 { static_cast<std::uint32_t>(seed) };
+        std::uint32_t k1 { static_cast<std::uint32_t>(seed >> 32) };
+
+        for (int round { 0 }; round < 10; ++round)
+        {
+            std::uint32_t high0 { }, low0 { }, high1 { }, low1 { };
+            mulHiLo(0xd2511f53, c0, high0, low0);
+            mulHiLo(0xcd9e8d57, c2, high1, low1);
+
+            c0 = high1 ^ c1 ^ k0;
+            c1 = low1;
+            c2 = high0 ^ c3 ^ k1;
+            c3 = low0;
+
+            k0 += 0x9e3779b9;
+            k1 += 0xbb67ae85;
+        }
+
+        return { c0, c1, c2, c3 };
+    }
+
+    inline constexpr std::size_t g_batchBlocks { 8 };
+
+    // generate() for counters counter .. counter + 7 into out[0 .. 31], round by round over the
+    // whole batch so the blocks' multiply chains overlap
+    inline void generateBatchScalar(std::uint64_t seed, std::uint64_t stream, std::uint64_t counter, std::uint32_t* out)
+    {
+        std::array<std::uint32_t, g_batchBlocks> c0 { }, c1 { }, c2 { }, c3 { };
+        for (std::size_t lane { 0 }; lane < g_batchBlocks; ++lane)
+        {
+            c0[lane] = static_cast<std::uint32_t>(counter + lane);
+            c1[lane] = static_cast<std::uint32_t>((counter + lane) >> 32);
+            c2[lane] = static_cast<std::uint32_t>(stream);
+            c3[lane] = static_cast<std::uint32_t>(stream >> 32);
+        }
+
+        std::uint32_t k0 { static_cast<std::uint32_t>(seed) };
+        std::uint32_t k1 { static_cast<std::uint32_t>(seed >> 32) };
+        for (int round { 0 }; round < 10; ++round)
+        {
+            for (std::size_t lane { 0 }; lane < g_batchBlocks; ++lane)
+            {
+                const std::uint64_t product0 { std::uint64_t { 0xd2511f53 } * c0[lane] };
+                const std::uint64_t product1 { std::uint64_t { 0xcd9e8d57 } * c2[lane] };
+
+                c0[lane] = static_cast<std::uint32_t>(product1 >> 32) ^ c1[lane] ^ k0;
+                c1[lane] = static_cast<std::uint32_t>(product1);
+                c2[lane] = static_cast<std::uint32_t>(product0 >> 32) ^ c3[lane] ^ k1;
+                c3[lane] = static_cast<std::uint32_t>(product0);
+            }
+
+            k0 += 0x9e3779b9;
+            k1 += 0xbb67ae85;
+        }
+
+        for (std::size_t lane { 0 }; lane < g_batchBlocks; ++lane)
+        {
+            out[4 * lane] = c0[lane];
+            out[4 * lane + 1] = c1[lane];
+            out[4 * lane + 2] = c2[lane];
+            out[4 * lane + 3] = c3[lane];
+        }
+    }
+
+#ifdef CPUFEATURES_X86
+    // high and low halves of the 32 x 32-bit products of every lane: vpmuludq takes the even
+    // lanes, the odd ones are shifted down first
+    __attribute__((target("avx2"))) inline void mulHiLoAvx2(__m256i a, __m256i b, __m256i& high, __m256i& low)
+    {
+        const __m256i even { _mm256_mul_epu32(a, b) };
+        const __m256i odd { _mm256_mul_epu32(_mm256_srli_epi64(a, 32), b) };
+        high = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0b10101010);
+        low = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0b10101010);
+    }
+
+    // The same batch with block `lane` in lane `lane` of four registers (one per counter word),
+    // transposed back to block order at the end
+    __attribute__((target("avx2"))) inline void generateBatchAvx2(std::uint64_t seed, std::uint64_t stream,
+        std::uint64_t counter, std::uint32_t* out)
+    {
+        std::array<std::uint32_t, g_batchBlocks> low { }, high { };
+        for (std::size_t lane { 0 }; lane < g_batchBlocks; ++lane)
+        {
+            low[lane] = static_cast<std::uint32_t>(counter + lane);
+            high[lane] = static_cast<std::uint32_t>((counter + lane) >> 32);
+        }
+
+        __m256i c0 { _mm256_loadu_si256(reinterpret_cast<const __m256i*>(low.data())) };
+        __m256i c1 { _mm256_loadu_si256(reinterpret_cast<const __m256i*>(high.data())) };
+        __m256i c2 { _mm256_set1_epi32(static_cast<int>(static_cast<std::uint32_t>(stream))) };
+        __m256i c3 { _mm256_set1_epi32(static_cast<int>(static_cast<std::uint32_t>(stream >> 32))) };
+        const __m256i multiplier0 { _mm256_set1_epi32(static_cast<int>(0xd2511f53)) };
+        const __m256i multiplier1 { _mm256_set1_epi32(static_cast<int>(0xcd9e8d57)) };
+
+        std::uint32_t k0 { static_cast<std::uint32_t>(seed) };
+        std::uint32_t k1 { static_cast<std::uint32_t>(seed >> 32) };
+        for (int round { 0 }; round < 10; ++round)
+        {
+            __m256i high0 { }, low0 { }, high1 { }, low1 { };
+            mulHiLoAvx2(c0, multiplier0, high0, low0);
+            mulHiLoAvx2(c2, multiplier1, high1, low1);
+
+            c0 = _mm256_xor_si256(_mm256_xor_si256(high1, c1), _mm256_set1_epi32(static_cast<int>(k0)));
+            c1 = low1;
+            c2 = _mm256_xor_si256(_mm256_xor_si256(high0, c3), _mm256_set1_epi32(static_cast<int>(k1)));
+            c3 = low0;
+
+            k0 += 0x9e3779b9;
+            k1 += 0xbb67ae85;
+        }
+
+        // 4 x 8 transpose: within each 128-bit half, blocks 0..3 (and 4..7) become rows
+        const __m256i t0 { _mm256_unpacklo_epi32(c0, c1) };
+        const __m256i t1 { _mm256_unpackhi_epi32(c0, c1) };
+        const __m256i t2 { _mm256_unpacklo_epi32(c2, c3) };
+        const __m256i t3 { _mm256_unpackhi_epi32(c2, c3) };
+        const __m256i blocks04 { _mm256_unpacklo_epi64(t0, t2) };
+        const __m256i blocks15 { _mm256_unpackhi_epi64(t0, t2) };
+        const __m256i blocks26 { _mm256_unpacklo_epi64(t1, t3) };
+        const __m256i blocks37 { _mm256_unpackhi_epi64(t1, t3) };
+
+        __m256i* pointer { reinterpret_cast<__m256i*>(out) };
+        _mm256_storeu_si256(pointer, _mm256_permute2x128_si256(blocks04, blocks15, 0x20));
+        _mm256_storeu_si256(pointer + 1, _mm256_permute2x128_si256(blocks26, blocks37, 0x20));
+        _mm256_storeu_si256(pointer + 2, _mm256_permute2x128_si256(blocks04, blocks15, 0x31));
+        _mm256_storeu_si256(pointer + 3, _mm256_permute2x128_si256(blocks26, blocks37, 0x31));
+    }
+#endif
+
+    inline void generateBatch(std::uint64_t seed, std::uint64_t stream, std::uint64_t counter, std::uint32_t* out,
+        RandomKernel kernel)
+    {
+        // a forced kernel this CPU lacks would be an illegal instruction
+        if (!isSupported(kernel))
+        {
+            kernel = getBestRandomKernel();
+        }
+
+#ifdef CPUFEATURES_X86
+        if (kernel == RandomKernel::avx2)
+        {
+            generateBatchAvx2(seed, stream, counter, out);
+            return;
+        }
+#endif
+        (void)kernel;
+        generateBatchScalar(seed, stream, counter, out);
+    }
+}
+
+// Value `index` of stream (seed, stream), without an engine
+inline std::uint32_t philoxAt(std::uint64_t seed, std::uint64_t stream, std::uint64_t index)
+{
+    return philox::generate(seed, stream, index / 4)[index % 4];
+}
+
+class Philox
+{
+private:
+    std::uint64_t m_seed { };
+    std::uint64_t m_stream { };
+    std::uint64_t m_counter { }; // of the next block
+    philox::Block m_block { };
+    std::size_t m_used { 4 };    // values of m_block already returned
+
+public:
+    using result_type = std::uint32_t;
+
+    // Starts at value `index` of the stream
+    explicit Philox(std::uint64_t seed = 5489, std::uint64_t stream = 0, std::uint64_t index = 0)
+        : m_seed { seed }
+        , m_stream { stream }
+    {
+        seek(index);
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    // O(1): the next value returned is value `index` of the stream
+    void seek(std::uint64_t index)
+    {
+        m_counter = index / 4;
+        m_used = 4;
+        if (index % 4 != 0)
+        {
+            m_block = philox::generate(m_seed, m_stream, m_counter++);
+            m_used = index % 4;
+        }
+    }
+
+    result_type operator()()
+    {
+        if (m_used == 4)
+        {
+            m_block = philox::generate(m_seed, m_stream, m_counter++);
+            m_used = 0;
+        }
+
+        return m_block[m_used++];
+    }
+
+    // Same values as calling operator() values.size() times, g_batchBlocks blocks at a time;
+    // both kernels give the same values, and a kernel the CPU doesn't support falls back to
+    // getBestRandomKernel()
+    void fill(std::span<std::uint32_t> values, RandomKernel kernel = getBestRandomKernel())
+    {
+        std::size_t i { 0 };
+        for (; i < values.size() && m_used < 4; ++i)
+        {
+            values[i] = m_block[m_used++];
+        }
+
+        for (; i + 4 * philox::g_batchBlocks <= values.size(); i += 4 * philox::g_batchBlocks)
+        {
+            philox::generateBatch(m_seed, m_stream, m_counter, values.data() + i, kernel);
+            m_counter += philox::g_batchBlocks;
+        }
+
+        for (; i + 4 <= values.size(); i += 4)
+        {
+            const philox::Block block { philox::generate(m_seed, m_stream, m_counter++) };
+            for (std::size_t j { 0 }; j < 4; ++j)
+            {
+                values[i + j] = block[j];
+            }
+        }
+
+        for (; i < values.size(); ++i)
+        {
+            values[i] = (*this)();
+        }
+    }
+};
+
+static_assert(std::uniform_random_bit_generator<Philox>);
+
+// values[i] = value `first + i` of stream (seed, stream), split over threadCount threads (0 counts
+// as 1): the result does not depend on threadCount
+inline void parallelFill(std::span<std::uint32_t> values, std::uint64_t seed, std::uint64_t stream,
+    unsigned threadCount, std::uint64_t first = 0)
+{
+    threadCount = std::max(1u, threadCount);
+
+    runOnThreads(threadCount,
+        [=](unsigned thread)
+        {
+            const std::size_t begin { values.size() * thread / threadCount };
+            const std::size_t end { values.size() * (thread + 1) / threadCount };
+
+            Philox engine { seed, stream, first + begin };
+            engine.fill(values.subspan(begin, end - begin));
+        });
+}
+
+#endif
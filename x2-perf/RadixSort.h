@@ -0,0 +1,147 @@
+#ifndef RADIXSORT_H
+#define RADIXSORT_H
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts> // for std::integral
+#include <cstddef> // for std::size_t
+#include <iterator> // for std::contiguous_iterator
+#include <memory> // for std::to_address
+#include <span>
+#include <type_traits> // for std::make_unsigned_t
+#include <vector>
+
+// LSD radix sort for integers.
+//
+// Keys are mapped to unsigned with the sign bit flipped, so negative values sort before positive
+// ones. 32/64-bit keys use 11-bit digits (3 and 6 passes), smaller keys use bytes. All digit
+// histograms are built in a single pass over the input, and a pass is skipped when every key
+// has the same value in that digit (common for small values in a wide type).
+
+namespace radix
+{
+    inline constexpr std::size_t g_smallArray { 64 }; // below this std::sort wins
+
+    template <std::integral T>
+    constexpr int getDigitBits()
+    {
+        return (sizeof(T) >= 4) ? 11 : 8;
+    }
+
+    template <std::integral T>
+    constexpr int getDigitCount()
+    {
+        constexpr int bits { static_cast<int>(sizeof(T)) * 8 };
+        return (bits + getDigitBits<T>() - 1) / getDigitBits<T>();
+    }
+
+    template <std::integral T>
+    constexpr std::make_unsigned_t<T> toKey(T value)
+    {
+        using Key = std::make_unsigned_t<T>;
+
+        if constexpr (std::is_signed_v<T>)
+        {
+            constexpr Key signBit { static_cast<Key>(Key { 1 } << (sizeof(T) * 8 - 1)) };
+            return static_cast<Key>(static_cast<Key>(value) ^ signBit);
+        }
+        else
+        {
+            return value;
+        }
+    }
+
+    template <std::integral T>
+    constexpr std::size_t getDigit(T value, int digit)
+    {
+        constexpr auto mask { (std::size_t { 1 } << getDigitBits<T>()) - 1 };
+        return static_cast<std::size_t>(toKey(value) >> (digit * getDigitBits<T>())) & mask;
+    }
+}
+
+// scratch must be at least as large as array
+template <std::integral T>
+    requires (!std::same_as<T, bool>)
+void radixSort(std::span<T> array, std::span<T> scratch)
+{
+    assert(scratch.size() >= array.size() && "Radix sort scratch buffer is too small");
+
+    const std::size_t size { array.size() };
+    if (size < radix::g_smallArray)
+    {
+        std::sort(array.begin(), array.end());
+        return;
+    }
+
+    constexpr int digitCount { radix::getDigitCount<T>() };
+    constexpr std::size_t bucketCount { std::size_t { 1 } << radix::getDigitBits<T>() };
+
+    std::vector<std::array<std::size_t, bucketCount>> counts(digitCount);
+
+    for (T value : array)
+    {
+        for (int digit { 0 }; digit < digitCount; ++digit)
+        {
+            ++counts[static_cast<std::size_t>(digit)][radix::getDigit(value, digit)];
+        }
+    }
+
+    T* from { array.data() };
+    T* to { scratch.data() };
+
+    for (int digit { 0 }; digit < digitCount; ++digit)
+    {
+        auto& count { counts[static_cast<std::size_t>(digit)] };
+
+        // every key shares this digit, the pass would not move anything
+        if (count[radix::getDigit(from[0], digit)] == size)
+        {
+            continue;
+        }
+
+        // turn counts into starting offsets
+        std::size_t offset { 0 };
+        for (auto& bucket : count)
+        {
+            std::size_t bucketSize { bucket };
+            bucket = offset;
+            offset += bucketSize;
+        }
+
+        for (std::size_t i { 0 }; i < size; ++i)
+        {
+            to[count[radix::getDigit(from[i], digit)]++] = from[i];
+        }
+
+        std::swap(from, to);
+    }
+
+    if (from != array.data())
+    {
+        std::copy(from, from + size, array.data());
+    }
+}
+
+template <std::integral T>
+    requires (!std::same_as<T, bool>)
+void radixSort(std::span<T> array)
+{
+    if (array.size() < radix::g_smallArray)
+    {
+        std::sort(array.begin(), array.end());
+        return;
+    }
+
+    std::vector<T> scratch(array.size());
+    radixSort(array, std::span<T> { scratch });
+}
+
+template <std::contiguous_iterator It>
+    requires std::integral<std::iter_value_t<It>>
+void radixSort(It first, It last)
+{
+    radixSort(std::span<std::iter_value_t<It>> { std::to_address(first), static_cast<std::size_t>(last - first) });
+}
+
+#endif
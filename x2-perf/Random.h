@@ -0,0 +1,373 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include "CpuFeatures.h"
+
+#include <algorithm>
+#include <array>
+#include <bit> // for std::rotl, std::rotr
+#include <concepts> // for std::uniform_random_bit_generator
+#include <cstddef> // for std::ptrdiff_t, std::size_t
+#include <cstdint> // for std::uint32_t, std::uint64_t
+#include <limits>
+#include <span>
+#include <string_view>
+
+#ifdef CPUFEATURES_X86
+#include <immintrin.h>
+#endif
+
+// Random number engines with explicit state, instead of the function-local static of LCG16() in
+// 07-control-flow-error-handling/prng_histogram.cpp: each object is its own stream, so threads
+// can have one each. All of them are UniformRandomBitGenerators (std::shuffle and the std
+// distributions take them) and have a bulk fill(span<uint32_t>).
+//
+//   Pcg32        - PCG-XSH-RR 64/32 (O'Neill): 16 bytes of state, one 32-bit output per step.
+//   Xoshiro256   - xoshiro256** (Blackman, Vigna): 32 bytes of state, 64-bit outputs.
+//   Xoshiro256x8 - 8 xoshiro256** streams 2^128 steps apart, stepped together. xoshiro256**
+//                  only needs shifts, adds and xors (x * 5 = (x << 2) + x), so 4 lanes fit in
+//                  an AVX2 register and fill runs two registers per step.
+//
+// Xoshiro256x8::fill takes an optional RandomKernel (default getBestRandomKernel()). A kernel the
+// CPU doesn't support (isSupported) falls back to getBestRandomKernel() rather than failing, so
+// forcing avx2 is safe on any machine and gives the same values.
+
+namespace prng
+{
+    inline std::uint64_t splitMix64(std::uint64_t& state)
+    {
+        state += 0x9e3779b97f4a7c15;
+        std::uint64_t z { state };
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+        return z ^ (z >> 31);
+    }
+
+    // One xoshiro256** step on s0..s3, wherever they are stored
+    inline std::uint64_t stepXoshiro(std::uint64_t& s0, std::uint64_t& s1, std::uint64_t& s2, std::uint64_t& s3)
+    {
+        const std::uint64_t result { std::rotl(s1 * 5, 7) * 9 };
+        const std::uint64_t t { s1 << 17 };
+
+        s2 ^= s0;
+        s3 ^= s1;
+        s1 ^= s2;
+        s0 ^= s3;
+        s2 ^= t;
+        s3 = std::rotl(s3, 45);
+
+        return result;
+    }
+
+    // 64-bit outputs into a span of 32-bit ones: low half first, an odd last element gets the
+    // low half of one more output
+    template <typename Next>
+    void fillHalves(std::span<std::uint32_t> values, Next next)
+    {
+        std::size_t i { 0 };
+        for (; i + 2 <= values.size(); i += 2)
+        {
+            const std::uint64_t value { next() };
+            values[i] = static_cast<std::uint32_t>(value);
+            values[i + 1] = static_cast<std::uint32_t>(value >> 32);
+        }
+
+        if (i < values.size())
+        {
+            values[i] = static_cast<std::uint32_t>(next());
+        }
+    }
+}
+
+class Pcg32
+{
+private:
+    std::uint64_t m_state { };
+    std::uint64_t m_increment { };
+
+public:
+    using result_type = std::uint32_t;
+
+    // Streams with different stream numbers never overlap, whatever the seeds
+    explicit Pcg32(std::uint64_t seed = 0x853c49e6748fea9b, std::uint64_t stream = 0xda3e39cb94b95bdb)
+        : m_increment { (stream << 1) | 1 }
+    {
+        (*this)();
+        m_state += seed;
+        (*this)();
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()()
+    {
+        const std::uint64_t old { m_state };
+        m_state = old * 6364136223846793005 + m_increment;
+
+        const auto xorShifted { static_cast<std::uint32_t>(((old >> 18) ^ old) >> 27) };
+        return std::rotr(xorShifted, static_cast<int>(old >> 59));
+    }
+
+    // Same values as calling operator() values.size() times
+    void fill(std::span<std::uint32_t> values)
+    {
+        for (std::uint32_t& value : values)
+        {
+            value = (*this)();
+        }
+    }
+};
+
+class Xoshiro256
+{
+private:
+    std::array<std::uint64_t, 4> m_state { };
+
+public:
+    using result_type = std::uint64_t;
+
+    // The state comes from splitmix64, as the xoshiro authors recommend
+    explicit Xoshiro256(std::uint64_t seed = 5489)
+    {
+        for (std::uint64_t& word : m_state)
+        {
+            word = prng::splitMix64(seed);
+        }
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()()
+    {
+        return prng::stepXoshiro(m_state[0], m_state[1], m_state[2], m_state[3]);
+    }
+
+    // Advances by 2^128 steps: jumping k times gives k streams that never overlap
+    void jump()
+    {
+        constexpr std::uint64_t s_jump[] { 0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c };
+
+        std::array<std::uint64_t, 4> jumped { };
+        for (std::uint64_t mask : s_jump)
+        {
+            for (int bit { 0 }; bit < 64; ++bit)
+            {
+                if (mask & (std::uint64_t { 1 } << bit))
+                {
+                    for (std::size_t i { 0 }; i < 4; ++i)
+                    {
+                        jumped[i] ^= m_state[i];
+                    }
+                }
+
+                (*this)();
+            }
+        }
+
+        m_state = jumped;
+    }
+
+    // Every 64-bit output fills two values, low half first
+    void fill(std::span<std::uint32_t> values)
+    {
+        prng::fillHalves(values, [this]() { return (*this)(); });
+    }
+
+    const std::array<std::uint64_t, 4>& getState() const { return m_state; }
+};
+
+enum class RandomKernel
+{
+    scalar,
+    avx2,
+};
+
+inline bool isSupported(RandomKernel kernel)
+{
+    return kernel == RandomKernel::scalar || hasAvx2();
+}
+
+inline RandomKernel getBestRandomKernel()
+{
+    return hasAvx2() ? RandomKernel::avx2 : RandomKernel::scalar;
+}
+
+inline std::string_view getRandomKernelName(RandomKernel kernel)
+{
+    return (kernel == RandomKernel::avx2) ? "avx2" : "scalar";
+}
+
+namespace prng
+{
+    inline constexpr std::size_t g_lanes { 8 };
+    inline constexpr std::size_t g_blockValues { 2 * g_lanes }; // uint32 values per step of all lanes
+
+    // state[word * g_lanes + lane]; every step writes lane 0..7's outputs, each as two uint32s
+    inline void generateScalar(std::uint64_t* state, std::uint32_t* values, std::size_t blocks)
+    {
+        for (std::size_t block { 0 }; block < blocks; ++block)
+        {
+            for (std::size_t lane { 0 }; lane < g_lanes; ++lane)
+            {
+                const std::uint64_t value { stepXoshiro(state[lane], state[g_lanes + lane], state[2 * g_lanes + lane],
+                    state[3 * g_lanes + lane]) };
+                values[2 * lane] = static_cast<std::uint32_t>(value);
+                values[2 * lane + 1] = static_cast<std::uint32_t>(value >> 32);
+            }
+
+            values += g_blockValues;
+        }
+    }
+
+#ifdef CPUFEATURES_X86
+    template <int Bits>
+    __attribute__((target("avx2"))) inline __m256i rotlAvx2(__m256i x)
+    {
+        return _mm256_or_si256(_mm256_slli_epi64(x, Bits), _mm256_srli_epi64(x, 64 - Bits));
+    }
+
+    __attribute__((target("avx2"))) inline __m256i stepXoshiroAvx2(__m256i& s0, __m256i& s1, __m256i& s2, __m256i& s3)
+    {
+        const __m256i times5 { _mm256_add_epi64(_mm256_slli_epi64(s1, 2), s1) };
+        const __m256i rotated { rotlAvx2<7>(times5) };
+        const __m256i result { _mm256_add_epi64(_mm256_slli_epi64(rotated, 3), rotated) };
+        const __m256i t { _mm256_slli_epi64(s1, 17) };
+
+        s2 = _mm256_xor_si256(s2, s0);
+        s3 = _mm256_xor_si256(s3, s1);
+        s1 = _mm256_xor_si256(s1, s2);
+        s0 = _mm256_xor_si256(s0, s3);
+        s2 = _mm256_xor_si256(s2, t);
+        s3 = rotlAvx2<45>(s3);
+
+        return result;
+    }
+
+    // state word `word` of lanes 0..3 (half 0) or 4..7 (half 1)
+    __attribute__((target("avx2"))) inline __m256i loadLanesAvx2(const std::uint64_t* state, std::size_t word, std::size_t half)
+    {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + word * g_lanes + half * 4));
+    }
+
+    // Lanes 0..3 and 4..7 in two independent sets of registers, so their dependency chains overlap.
+    // A 64-bit lane stored little-endian is exactly its low then high uint32.
+    __attribute__((target("avx2"))) inline void generateAvx2(std::uint64_t* state, std::uint32_t* values, std::size_t blocks)
+    {
+        __m256i a0 { loadLanesAvx2(state, 0, 0) }, a1 { loadLanesAvx2(state, 1, 0) };
+        __m256i a2 { loadLanesAvx2(state, 2, 0) }, a3 { loadLanesAvx2(state, 3, 0) };
+        __m256i b0 { loadLanesAvx2(state, 0, 1) }, b1 { loadLanesAvx2(state, 1, 1) };
+        __m256i b2 { loadLanesAvx2(state, 2, 1) }, b3 { loadLanesAvx2(state, 3, 1) };
+
+        for (std::size_t block { 0 }; block < blocks; ++block)
+        {
+            const __m256i low { stepXoshiroAvx2(a0, a1, a2, a3) };
+            const __m256i high { stepXoshiroAvx2(b0, b1, b2, b3) };
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(values), low);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(values + 8), high);
+            values += g_blockValues;
+        }
+
+        const __m256i registers[4][2] { { a0, b0 }, { a1, b1 }, { a2, b2 }, { a3, b3 } };
+        for (std::size_t word { 0 }; word < 4; ++word)
+        {
+            for (std::size_t half { 0 }; half < 2; ++half)
+            {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(state + word * g_lanes + half * 4), registers[word][half]);
+            }
+        }
+    }
+#endif
+
+    inline void generate(std::uint64_t* state, std::uint32_t* values, std::size_t blocks, RandomKernel kernel)
+    {
+        // a forced kernel this CPU lacks would be an illegal instruction
+        if (!isSupported(kernel))
+        {
+            kernel = getBestRandomKernel();
+        }
+
+#ifdef CPUFEATURES_X86
+        if (kernel == RandomKernel::avx2)
+        {
+            generateAvx2(state, values, blocks);
+            return;
+        }
+#endif
+        (void)kernel;
+        generateScalar(state, values, blocks);
+    }
+}
+
+// Both kernels give the same values, and fill gives the same values as calling operator() as
+// often, however the calls are split up
+class Xoshiro256x8
+{
+private:
+    std::array<std::uint64_t, 4 * prng::g_lanes> m_state { };
+    std::array<std::uint32_t, prng::g_blockValues> m_buffer { }; // for single values and tails
+    std::size_t m_buffered { 0 }; // unread values at the end of m_buffer
+
+    void refill(RandomKernel kernel)
+    {
+        prng::generate(m_state.data(), m_buffer.data(), 1, kernel);
+        m_buffered = m_buffer.size();
+    }
+
+public:
+    using result_type = std::uint32_t;
+
+    // Lane k starts where Xoshiro256 { seed } is after k jumps
+    explicit Xoshiro256x8(std::uint64_t seed = 5489)
+    {
+        Xoshiro256 lane { seed };
+        for (std::size_t k { 0 }; k < prng::g_lanes; ++k)
+        {
+            for (std::size_t word { 0 }; word < 4; ++word)
+            {
+                m_state[word * prng::g_lanes + k] = lane.getState()[word];
+            }
+
+            lane.jump();
+        }
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()()
+    {
+        if (m_buffered == 0)
+        {
+            refill(RandomKernel::scalar);
+        }
+
+        return m_buffer[m_buffer.size() - m_buffered--];
+    }
+
+    void fill(std::span<std::uint32_t> values, RandomKernel kernel = getBestRandomKernel())
+    {
+        const std::size_t fromBuffer { std::min(m_buffered, values.size()) };
+        std::copy_n(m_buffer.end() - static_cast<std::ptrdiff_t>(m_buffered), fromBuffer, values.begin());
+        m_buffered -= fromBuffer;
+        values = values.subspan(fromBuffer);
+
+        const std::size_t blocks { values.size() / prng::g_blockValues };
+        prng::generate(m_state.data(), values.data(), blocks, kernel);
+        values = values.subspan(blocks * prng::g_blockValues);
+
+        if (!values.empty())
+        {
+            refill(kernel);
+            std::copy_n(m_buffer.begin(), values.size(), values.begin());
+            m_buffered -= values.size();
+        }
+    }
+};
+
+static_assert(std::uniform_random_bit_generator<Pcg32>);
+static_assert(std::uniform_random_bit_generator<Xoshiro256>);
+static_assert(std::uniform_random_bit_generator<Xoshiro256x8>);
+
+#endif
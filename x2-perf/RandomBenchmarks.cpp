@@ -0,0 +1,403 @@
+#include "BoundedRandom.h"
+#include "Philox.h"
+#include "Random.h"
+#include "Suites.h"
+
+#include <algorithm>
+#include <cstdint> // for std::uint32_t, std::uint64_t
+#include <functional> // for std::ref
+#include <limits>
+#include <memory> // for std::shared_ptr
+#include <random>
+#include <span>
+#include <string>
+#include <utility> // for std::exchange
+#include <vector>
+
+namespace
+{
+    // LCG16() from 07-control-flow-error-handling/prng_histogram.cpp, returning the whole state
+    // instead of % 50
+    unsigned int LCG16()
+    {
+        static unsigned int s_state { 7272 };
+
+        s_state = 8234233 * s_state + 2372983;
+
+        return s_state;
+    }
+
+    // The engines restart from the seed before every run; checks compare fill against the same
+    // number of operator() calls on a fresh engine
+    struct RandomFixture
+    {
+        std::uint64_t seed { };
+        std::vector<std::uint32_t> values { };
+        std::mt19937 mt { };
+        Pcg32 pcg { };
+        Xoshiro256 xoshiro { };
+        Xoshiro256x8 lanes { };
+        Philox philox { };
+
+        void prepare(std::size_t size)
+        {
+            values.resize(size);
+            mt.seed(static_cast<std::mt19937::result_type>(seed));
+            pcg = Pcg32 { seed };
+            xoshiro = Xoshiro256 { seed };
+            lanes = Xoshiro256x8 { seed };
+            philox = Philox { seed };
+        }
+
+        template <typename Engine>
+        bool isSequenceOf(Engine engine) const
+        {
+            return std::all_of(values.begin(), values.end(),
+                [&engine](std::uint32_t value) { return value == static_cast<std::uint32_t>(engine()); });
+        }
+    };
+}
+
+void addRandomCases(BenchmarkSuite& suite, const SuiteOptions& options)
+{
+    auto fixture { std::make_shared<RandomFixture>() };
+    fixture->seed = options.seed;
+
+    for (std::size_t size { options.minSize }; size <= options.maxSize; size *= 10)
+    {
+        const std::string group { "random/" + std::to_string(size) };
+        const auto items { static_cast<double>(size) };
+        const auto bytes { static_cast<double>(size * sizeof(std::uint32_t)) };
+        auto setup { [fixture, size]() { fixture->prepare(size); } };
+
+        suite.add({
+            group, "LCG16", setup,
+            [fixture]()
+            {
+                for (std::uint32_t& value : fixture->values)
+                {
+                    value = LCG16();
+                }
+            },
+            [fixture]() { return fixture->values.size() < 2 || fixture->values[0] != fixture->values[1]; },
+            items, bytes,
+        });
+
+        suite.add({
+            group, "std::mt19937", setup,
+            [fixture]() { std::generate(fixture->values.begin(), fixture->values.end(), std::ref(fixture->mt)); },
+            [fixture]() { return fixture->isSequenceOf(std::mt19937 { static_cast<std::mt19937::result_type>(fixture->seed) }); },
+            items, bytes,
+        });
+
+        suite.add({
+            group, "Pcg32::fill", setup,
+            [fixture]() { fixture->pcg.fill(fixture->values); },
+            [fixture]() { return fixture->isSequenceOf(Pcg32 { fixture->seed }); },
+            items, bytes,
+        });
+
+        suite.add({
+            group, "Xoshiro256::fill", setup,
+            [fixture]() { fixture->xoshiro.fill(fixture->values); },
+            [fixture]()
+            {
+                std::vector<std::uint32_t> expected(fixture->values.size());
+                Xoshiro256 engine { fixture->seed };
+                prng::fillHalves(expected, [&engine]() { return engine(); });
+                return fixture->values == expected;
+            },
+            items, bytes,
+        });
+
+        for (RandomKernel kernel : { RandomKernel::scalar, RandomKernel::avx2 })
+        {
+            if (!isSupported(kernel))
+            {
+                continue;
+            }
+
+            suite.add({
+                group, "Xoshiro256x8::fill/" + std::string { getRandomKernelName(kernel) }, setup,
+                [fixture, kernel]() { fixture->lanes.fill(fixture->values, kernel); },
+                [fixture]() { return fixture->isSequenceOf(Xoshiro256x8 { fixture->seed }); },
+                items, bytes,
+            });
+        }
+
+        for (RandomKernel kernel : { RandomKernel::scalar, RandomKernel::avx2 })
+        {
+            if (!isSupported(kernel))
+            {
+                continue;
+            }
+
+            suite.add({
+                group, "Philox::fill/" + std::string { getRandomKernelName(kernel) }, setup,
+                [fixture, kernel]() { fixture->philox.fill(fixture->values, kernel); },
+                [fixture]() { return fixture->isSequenceOf(Philox { fixture->seed }); },
+                items, bytes,
+            });
+        }
+
+        if (size == 0)
+        {
+            break;
+        }
+    }
+}
+
+namespace
+{
+#ifdef __SIZEOF_INT128__
+    __extension__ using Uint128 = unsigned __int128;
+
+    // A uniform value in [0, range) from random values of `bits` bits, the slow way: the whole
+    // product in 128 bits, and products whose low `bits` bits are below 2^bits % range (the
+    // incomplete last round) are redrawn, so every result has the same number of accepted values
+    template <typename Next>
+    std::uint32_t getReferenceBounded(Next next, int bits, std::uint32_t range)
+    {
+        const Uint128 modulus { Uint128 { 1 } << bits };
+        const Uint128 threshold { modulus % range };
+
+        while (true)
+        {
+            const Uint128 product { Uint128 { next() } * range };
+            if (product % modulus >= threshold)
+            {
+                return static_cast<std::uint32_t>(product / modulus);
+            }
+        }
+    }
+
+    std::uint64_t getUint64(Xoshiro256x8& engine)
+    {
+        const std::uint64_t low { engine() };
+        return low | (std::uint64_t { engine() } << 32);
+    }
+#endif
+
+    struct BoundedFixture
+    {
+        std::uint64_t seed { };
+        std::vector<std::uint32_t> values { };
+        Pcg32 pcg { };
+        Xoshiro256 xoshiro { };
+        Xoshiro256x8 lanes { };
+
+        void prepare(std::size_t size)
+        {
+            values.resize(size);
+            pcg = Pcg32 { seed };
+            xoshiro = Xoshiro256 { seed };
+            lanes = Xoshiro256x8 { seed };
+        }
+
+        bool isInRange(std::uint32_t range) const
+        {
+            return std::all_of(values.begin(), values.end(), [range](std::uint32_t value) { return value < range; });
+        }
+
+#ifdef __SIZEOF_INT128__
+        // boundedRandom on a fresh engine: one value of the engine's width per try
+        template <typename Engine>
+        bool isBoundedRandom(std::uint32_t range) const
+        {
+            Engine engine { seed };
+            const int bits { (Engine::max() > std::numeric_limits<std::uint32_t>::max()) ? 64 : 32 };
+            return std::all_of(values.begin(), values.end(),
+                [&](std::uint32_t value) { return value == getReferenceBounded([&]() { return engine(); }, bits, range); });
+        }
+
+        // fillBounded on a fresh Xoshiro256x8, whose values are one sequence however they are
+        // drawn: narrow ranges take one 32-bit value per result from a bulk fill of all of them,
+        // wide ones two per result (low half first) from a bulk fill of g_wideChunk results; the
+        // redraws of a chunk come after it, in order
+        bool isFillBounded(std::uint32_t range) const
+        {
+            Xoshiro256x8 engine { seed };
+            const bool isWide { range > bounded::g_narrowRangeLimit };
+            const std::size_t chunk { isWide ? bounded::g_wideChunk : std::max<std::size_t>(values.size(), 1) };
+            std::vector<std::uint64_t> random { };
+
+            for (std::size_t first { 0 }; first < values.size(); first += chunk)
+            {
+                const std::size_t count { std::min(chunk, values.size() - first) };
+                random.resize(count);
+                for (std::uint64_t& value : random)
+                {
+                    value = isWide ? getUint64(engine) : engine();
+                }
+
+                for (std::size_t i { 0 }; i < count; ++i)
+                {
+                    bool isFirst { true };
+                    auto next {
+                        [&]() -> std::uint64_t
+                        {
+                            if (std::exchange(isFirst, false))
+                            {
+                                return random[i];
+                            }
+
+                            return isWide ? getUint64(engine) : engine();
+                        }
+                    };
+
+                    if (values[first + i] != getReferenceBounded(next, isWide ? 64 : 32, range))
+                    {
+                        return false;
+                    }
+                }
+            }
+
+            return true;
+        }
+#else
+        template <typename Engine>
+        bool isBoundedRandom(std::uint32_t range) const { return isInRange(range); }
+        bool isFillBounded(std::uint32_t range) const { return isInRange(range); }
+#endif
+    };
+}
+
+void addBoundedRandomCases(BenchmarkSuite& suite, const SuiteOptions& options)
+{
+    auto fixture { std::make_shared<BoundedFixture>() };
+    fixture->seed = options.seed;
+
+    // 50 as in prng_histogram.cpp; 2^31 + 1 is the worst case for rejection (almost half redrawn)
+    for (std::uint32_t range : { 50u, 2147483649u })
+    {
+        for (std::size_t size { options.minSize }; size <= options.maxSize; size *= 10)
+        {
+            const std::string group { "bounded/" + std::to_string(range) + "/" + std::to_string(size) };
+            const auto items { static_cast<double>(size) };
+            const auto bytes { static_cast<double>(size * sizeof(std::uint32_t)) };
+            auto setup { [fixture, size]() { fixture->prepare(size); } };
+            auto checkRange { [fixture, range]() { return fixture->isInRange(range); } };
+
+            // biased, and a division per value
+            suite.add({
+                group, "% range", setup,
+                [fixture, range]()
+                {
+                    for (std::uint32_t& value : fixture->values)
+                    {
+                        value = bounded::nextUint32(fixture->xoshiro) % range;
+                    }
+                },
+                checkRange, items, bytes,
+            });
+
+            // a new distribution per value, like getMultiplier() in 07_square_num_game.cpp
+            suite.add({
+                group, "std::uniform_int_distribution", setup,
+                [fixture, range]()
+                {
+                    for (std::uint32_t& value : fixture->values)
+                    {
+                        std::uniform_int_distribution<std::uint32_t> distribution { 0, range - 1 };
+                        value = distribution(fixture->xoshiro);
+                    }
+                },
+                checkRange, items, bytes,
+            });
+
+            suite.add({
+                group, "boundedRandom", setup,
+                [fixture, range]()
+                {
+                    for (std::uint32_t& value : fixture->values)
+                    {
+                        value = boundedRandom(fixture->xoshiro, range);
+                    }
+                },
+                [fixture, range]() { return fixture->isBoundedRandom<Xoshiro256>(range); }, items, bytes,
+            });
+
+            // 32-bit engine: the narrow path, which redraws almost half the values of 2^31 + 1
+            suite.add({
+                group, "boundedRandom(Pcg32)", setup,
+                [fixture, range]()
+                {
+                    for (std::uint32_t& value : fixture->values)
+                    {
+                        value = boundedRandom(fixture->pcg, range);
+                    }
+                },
+                [fixture, range]() { return fixture->isBoundedRandom<Pcg32>(range); }, items, bytes,
+            });
+
+            for (RandomKernel kernel : { RandomKernel::scalar, RandomKernel::avx2 })
+            {
+                if (!isSupported(kernel))
+                {
+                    continue;
+                }
+
+                suite.add({
+                    group, "fillBounded/" + std::string { getRandomKernelName(kernel) }, setup,
+                    [fixture, range, kernel]() { fillBounded(fixture->lanes, fixture->values, range, kernel); },
+                    [fixture, range]() { return fixture->isFillBounded(range); }, items, bytes,
+                });
+            }
+
+            if (size == 0)
+            {
+                break;
+            }
+        }
+    }
+}
+
+namespace
+{
+    // expected is one engine's sequence, made once per size; parallel fills must match it exactly
+    struct ParallelRandomFixture
+    {
+        std::uint64_t seed { };
+        std::vector<std::uint32_t> values { };
+        std::vector<std::uint32_t> expected { };
+
+        void prepare(std::size_t size)
+        {
+            values.assign(size, 0);
+            if (expected.size() != size)
+            {
+                expected.resize(size);
+                Philox { seed }.fill(expected);
+            }
+        }
+    };
+}
+
+void addParallelRandomCases(BenchmarkSuite& suite, const SuiteOptions& options)
+{
+    auto fixture { std::make_shared<ParallelRandomFixture>() };
+    fixture->seed = options.seed;
+
+    for (std::size_t size { options.minSize }; size <= options.maxSize; size *= 10)
+    {
+        const std::string group { "random-threads/" + std::to_string(size) };
+        const auto items { static_cast<double>(size) };
+        const auto bytes { static_cast<double>(size * sizeof(std::uint32_t)) };
+        auto setup { [fixture, size]() { fixture->prepare(size); } };
+
+        for (unsigned threads { 1 }; threads <= options.maxThreads; threads *= 2)
+        {
+            suite.add({
+                group, "parallelFill/" + std::to_string(threads) + "t", setup,
+                [fixture, threads]() { parallelFill(fixture->values, fixture->seed, 0, threads); },
+                [fixture]() { return fixture->values == fixture->expected; },
+                items, bytes, threads,
+            });
+        }
+
+        if (size == 0)
+        {
+            break;
+        }
+    }
+}
@@ -0,0 +1,226 @@
+#include "RecordSort.h"
+#include "Suites.h"
+
+#include <algorithm>
+#include <cstdint> // for std::uint32_t
+#include <memory> // for std::shared_ptr
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    // Same record as 11-arrays-strings-dynamic-allocation/sort_student_grades.cpp
+    struct Student
+    {
+        std::string name { };
+        int grade { };
+    };
+
+    bool greatest_grade(Student a, Student b)
+    {
+        return (a.grade > b.grade);
+    }
+
+    bool greatestGrade(const Student& a, const Student& b)
+    {
+        return (a.grade > b.grade);
+    }
+
+    int getGrade(const Student& student)
+    {
+        return student.grade;
+    }
+
+    bool isSameStudent(const Student& a, const Student& b)
+    {
+        return a.name == b.name && a.grade == b.grade;
+    }
+
+    // Students of the current size and grade range, made once per size, with their stable sort
+    // by grade as the expected result
+    class RecordFixture
+    {
+    private:
+        std::uint64_t m_seed { };
+        std::size_t m_size { };
+        int m_maxGrade { };
+        bool m_hasInput { false };
+
+    public:
+        std::vector<Student> input { };
+        std::vector<Student> expected { };
+        std::vector<Student> work { };
+        std::vector<std::uint32_t> order { };
+
+        explicit RecordFixture(std::uint64_t seed)
+            : m_seed { seed }
+        {
+        }
+
+        void prepare(std::size_t size, int maxGrade)
+        {
+            if (m_hasInput && m_size == size && m_maxGrade == maxGrade)
+            {
+                return;
+            }
+
+            // free the previous size first, so only one is ever in memory
+            input = { };
+            expected = { };
+            work = { };
+            order = { };
+
+            input.resize(size);
+
+            std::mt19937_64 mt { m_seed };
+            std::uniform_int_distribution grades { 0, maxGrade };
+
+            for (std::size_t i { 0 }; i < size; ++i)
+            {
+                // long enough to not fit in the small string buffer, like real full names
+                input[i] = { "Student number " + std::to_string(i), grades(mt) };
+            }
+
+            expected = input;
+            std::stable_sort(expected.begin(), expected.end(), greatestGrade);
+
+            m_size = size;
+            m_maxGrade = maxGrade;
+            m_hasInput = true;
+        }
+
+        // the stable sorts must give exactly the expected records
+        bool isStableSorted() const
+        {
+            return std::equal(work.begin(), work.end(), expected.begin(), expected.end(), isSameStudent);
+        }
+
+        // std::sort may reorder equal grades: same grades as expected, and the same names within
+        // every run of one grade
+        bool isSorted() const
+        {
+            if (work.size() != expected.size())
+            {
+                return false;
+            }
+
+            std::vector<std::string_view> names { };
+            std::vector<std::string_view> expectedNames { };
+            std::size_t first { 0 };
+            while (first < work.size())
+            {
+                std::size_t last { first };
+                names.clear();
+                expectedNames.clear();
+                for (; last < work.size() && expected[last].grade == expected[first].grade; ++last)
+                {
+                    if (work[last].grade != expected[last].grade)
+                    {
+                        return false;
+                    }
+
+                    names.push_back(work[last].name);
+                    expectedNames.push_back(expected[last].name);
+                }
+
+                std::sort(names.begin(), names.end());
+                std::sort(expectedNames.begin(), expectedNames.end());
+                if (names != expectedNames)
+                {
+                    return false;
+                }
+
+                first = last;
+            }
+
+            return true;
+        }
+
+        bool isOrderSorted() const
+        {
+            SortedView<Student> view { input, order };
+            if (view.size() != expected.size())
+            {
+                return false;
+            }
+
+            for (std::size_t i { 0 }; i < view.size(); ++i)
+            {
+                if (!isSameStudent(view[i], expected[i]))
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+    };
+
+    void addRecordCases(BenchmarkSuite& suite, const std::string& group, const std::shared_ptr<RecordFixture>& fixture,
+        std::size_t size, int maxGrade)
+    {
+        const auto items { static_cast<double>(size) };
+        auto prepare { [fixture, size, maxGrade]() { fixture->prepare(size, maxGrade); } };
+        auto copyInput {
+            [fixture, size, maxGrade]()
+            {
+                fixture->prepare(size, maxGrade);
+                fixture->work = fixture->input;
+            }
+        };
+        auto isSorted { [fixture]() { return fixture->isSorted(); } };
+        auto isStableSorted { [fixture]() { return fixture->isStableSorted(); } };
+
+        suite.add({
+            group, "std::sort(by value)", copyInput,
+            [fixture]() { std::sort(fixture->work.begin(), fixture->work.end(), greatest_grade); },
+            isSorted, items, 0.0,
+        });
+
+        suite.add({
+            group, "std::sort(const&)", copyInput,
+            [fixture]() { std::sort(fixture->work.begin(), fixture->work.end(), greatestGrade); },
+            isSorted, items, 0.0,
+        });
+
+        suite.add({
+            group, "std::stable_sort(const&)", copyInput,
+            [fixture]() { std::stable_sort(fixture->work.begin(), fixture->work.end(), greatestGrade); },
+            isStableSorted, items, 0.0,
+        });
+
+        suite.add({
+            group, "sortByKey", copyInput,
+            [fixture]() { sortByKey(std::span<Student> { fixture->work }, getGrade, SortOrder::descending); },
+            isStableSorted, items, 0.0,
+        });
+
+        suite.add({
+            group, "sortedOrder(view)", prepare,
+            [fixture]()
+            {
+                fixture->order = sortedOrder(std::span<const Student> { fixture->input }, getGrade, SortOrder::descending);
+            },
+            [fixture]() { return fixture->isOrderSorted(); }, items, 0.0,
+        });
+    }
+}
+
+void addSortRecordsCases(BenchmarkSuite& suite, const SuiteOptions& options)
+{
+    auto fixture { std::make_shared<RecordFixture>(options.seed) };
+
+    for (std::size_t size { options.minSize }; size <= options.maxSize; size *= 10)
+    {
+        addRecordCases(suite, "sort-records/grades/" + std::to_string(size), fixture, size, 100);
+        addRecordCases(suite, "sort-records/wide-keys/" + std::to_string(size), fixture, size, 1'000'000'000);
+
+        if (size == 0)
+        {
+            break;
+        }
+    }
+}
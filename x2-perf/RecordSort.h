@@ -0,0 +1,195 @@
+#ifndef RECORDSORT_H
+#define RECORDSORT_H
+
+#include "RadixSort.h"
+
+#include <algorithm>
+#include <cassert>
+#include <concepts> // for std::integral
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::int32_t, std::int64_t, std::uint32_t, std::uint64_t
+#include <limits>
+#include <span>
+#include <type_traits> // for std::invoke_result_t
+#include <utility> // for std::move
+#include <vector>
+
+// Sorting records by an integer key without moving (or copying) the records while sorting.
+//
+// sortedOrder() pulls the key out of every record once and sorts (key, index) pairs instead
+// of the records. The result is a permutation: order[i] is the index of the record that belongs
+// at position i. Records with equal keys keep their original order (the sort is stable).
+// Small key ranges (like grades) use a counting sort, anything else is packed into 64-bit
+// (key, index) words and radix sorted.
+//
+// The permutation can then be applied once with applyPermutation(), or not at all by reading
+// the records through a SortedView.
+
+enum class SortOrder
+{
+    ascending,
+    descending,
+};
+
+inline constexpr std::uint64_t g_maxCountingRange { 1 << 16 }; // counting sort up to this many keys
+
+template <typename Record, typename KeyFn>
+    requires std::integral<std::invoke_result_t<KeyFn, const Record&>>
+std::vector<std::uint32_t> sortedOrder(std::span<const Record> records, KeyFn getKey,
+    SortOrder order = SortOrder::ascending)
+{
+    assert(records.size() <= std::numeric_limits<std::uint32_t>::max() && "Too many records for 32-bit indices");
+
+    const std::size_t size { records.size() };
+    std::vector<std::uint32_t> result(size);
+    if (size == 0)
+    {
+        return result;
+    }
+
+    // keys as unsigned 32-bit values that sort in the requested order
+    std::vector<std::uint32_t> keys(size);
+    for (std::size_t i { 0 }; i < size; ++i)
+    {
+        auto key { static_cast<std::int64_t>(getKey(records[i])) };
+        assert(key >= std::numeric_limits<std::int32_t>::min() && key <= std::numeric_limits<std::int32_t>::max()
+            && "Key does not fit in 32 bits");
+
+        keys[i] = radix::toKey(static_cast<std::int32_t>(key));
+        if (order == SortOrder::descending)
+        {
+            keys[i] = ~keys[i];
+        }
+    }
+
+    const auto [minKey, maxKey] { std::minmax_element(keys.begin(), keys.end()) };
+    const std::uint32_t lowest { *minKey };
+    const std::uint64_t range { std::uint64_t { *maxKey } - lowest + 1 };
+
+    if (range <= g_maxCountingRange)
+    {
+        std::vector<std::size_t> offsets(range + 1);
+        for (std::uint32_t key : keys)
+        {
+            ++offsets[key - lowest + 1];
+        }
+
+        for (std::size_t bucket { 1 }; bucket <= range; ++bucket)
+        {
+            offsets[bucket] += offsets[bucket - 1];
+        }
+
+        for (std::size_t i { 0 }; i < size; ++i)
+        {
+            result[offsets[keys[i] - lowest]++] = static_cast<std::uint32_t>(i);
+        }
+
+        return result;
+    }
+
+    // key in the high half, index in the low half: equal keys stay in index order
+    std::vector<std::uint64_t> packed(size);
+    for (std::size_t i { 0 }; i < size; ++i)
+    {
+        packed[i] = (std::uint64_t { keys[i] } << 32) | i;
+    }
+
+    radixSort(std::span<std::uint64_t> { packed });
+
+    for (std::size_t i { 0 }; i < size; ++i)
+    {
+        result[i] = static_cast<std::uint32_t>(packed[i]);
+    }
+
+    return result;
+}
+
+// Moves every record exactly once into place, by following the cycles of the permutation
+template <typename Record>
+void applyPermutation(std::span<Record> records, std::span<const std::uint32_t> order)
+{
+    assert(records.size() == order.size() && "Permutation does not match the records");
+
+    std::vector<bool> placed(records.size());
+
+    for (std::size_t start { 0 }; start < records.size(); ++start)
+    {
+        if (placed[start])
+        {
+            continue;
+        }
+
+        // position start wants records[order[start]], which wants records[order[order[start]]]...
+        Record saved { std::move(records[start]) };
+        std::size_t current { start };
+
+        while (true)
+        {
+            placed[current] = true;
+            std::size_t next { order[current] };
+
+            if (next == start)
+            {
+                records[current] = std::move(saved);
+                break;
+            }
+
+            records[current] = std::move(records[next]);
+            current = next;
+        }
+    }
+}
+
+template <typename Record, typename KeyFn>
+void sortByKey(std::span<Record> records, KeyFn getKey, SortOrder order = SortOrder::ascending)
+{
+    auto permutation { sortedOrder(std::span<const Record> { records }, getKey, order) };
+    applyPermutation(records, std::span<const std::uint32_t> { permutation });
+}
+
+// Reads records in sorted order without moving them
+template <typename Record>
+class SortedView
+{
+private:
+    std::span<const Record> m_records { };
+    std::vector<std::uint32_t> m_order { };
+
+public:
+    class Iterator
+    {
+    private:
+        const SortedView* m_view { nullptr };
+        std::size_t m_index { };
+
+    public:
+        Iterator(const SortedView* view, std::size_t index)
+            : m_view { view }, m_index { index }
+        {
+        }
+
+        const Record& operator*() const { return (*m_view)[m_index]; }
+        Iterator& operator++() { ++m_index; return *this; }
+        bool operator==(const Iterator& other) const { return m_index == other.m_index; }
+    };
+
+    SortedView(std::span<const Record> records, std::vector<std::uint32_t> order)
+        : m_records { records }, m_order { std::move(order) }
+    {
+        assert(m_records.size() == m_order.size() && "Permutation does not match the records");
+    }
+
+    std::size_t size() const { return m_order.size(); }
+    const Record& operator[](std::size_t index) const { return m_records[m_order[index]]; }
+
+    Iterator begin() const { return { this, 0 }; }
+    Iterator end() const { return { this, m_order.size() }; }
+};
+
+template <typename Record, typename KeyFn>
+SortedView<Record> makeSortedView(std::span<const Record> records, KeyFn getKey, SortOrder order = SortOrder::ascending)
+{
+    return { records, sortedOrder(records, getKey, order) };
+}
+
+#endif
@@ -0,0 +1,150 @@
+#include "STree.h"
+
+#include "CpuFeatures.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+#ifdef CPUFEATURES_X86
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    constexpr std::size_t g_nodeKeys { static_cast<std::size_t>(g_sTreeNodeKeys) };
+    constexpr std::size_t g_fanOut { g_nodeKeys + 1 };
+
+    int countLess(const int* node, int target)
+    {
+        int count { 0 };
+        for (std::size_t i { 0 }; i < g_nodeKeys; ++i)
+        {
+            count += (node[i] < target);
+        }
+
+        return count;
+    }
+
+    std::size_t lowerBoundScalar(const int* nodes, const std::size_t* offsets, const std::size_t* counts,
+        std::size_t height, int target)
+    {
+        std::size_t node { 0 };
+        for (std::size_t level { 0 }; level + 1 < height; ++level)
+        {
+            std::size_t child { node * g_fanOut + static_cast<std::size_t>(countLess(nodes + offsets[level] + node * g_nodeKeys, target)) };
+
+            // past the last node below only when target is above every key: the last node says so too
+            node = std::min(child, counts[level + 1] - 1);
+        }
+
+        return node * g_nodeKeys + static_cast<std::size_t>(countLess(nodes + offsets[height - 1] + node * g_nodeKeys, target));
+    }
+
+#ifdef CPUFEATURES_X86
+    __attribute__((target("avx2"))) inline int countLessAvx2(const int* node, __m256i target)
+    {
+        __m256i low { _mm256_load_si256(reinterpret_cast<const __m256i*>(node)) };
+        __m256i high { _mm256_load_si256(reinterpret_cast<const __m256i*>(node + 8)) };
+
+        auto lowMask { static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(target, low)))) };
+        auto highMask { static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(target, high)))) };
+
+        return __builtin_popcount(lowMask | (highMask << 8));
+    }
+
+    __attribute__((target("avx2"))) std::size_t lowerBoundAvx2(const int* nodes, const std::size_t* offsets,
+        const std::size_t* counts, std::size_t height, int target)
+    {
+        const __m256i broadcast { _mm256_set1_epi32(target) };
+
+        std::size_t node { 0 };
+        for (std::size_t level { 0 }; level + 1 < height; ++level)
+        {
+            std::size_t child { node * g_fanOut + static_cast<std::size_t>(countLessAvx2(nodes + offsets[level] + node * g_nodeKeys, broadcast)) };
+            node = std::min(child, counts[level + 1] - 1);
+        }
+
+        return node * g_nodeKeys + static_cast<std::size_t>(countLessAvx2(nodes + offsets[height - 1] + node * g_nodeKeys, broadcast));
+    }
+#endif
+}
+
+STreeIndex::STreeIndex(std::span<const int> sorted)
+    : m_size { sorted.size() }
+{
+    assert(std::is_sorted(sorted.begin(), sorted.end()) && "S-tree needs sorted keys");
+
+    // node counts bottom up: leaves, then one parent per 17 children up to a single root
+    std::vector<std::size_t> counts { std::max<std::size_t>(1, (m_size + g_nodeKeys - 1) / g_nodeKeys) };
+    while (counts.back() > 1)
+    {
+        counts.push_back((counts.back() + g_fanOut - 1) / g_fanOut);
+    }
+
+    std::reverse(counts.begin(), counts.end());
+    m_levelNodes = counts;
+
+    std::size_t total { 0 };
+    for (std::size_t count : counts)
+    {
+        m_levelOffsets.push_back(total);
+        total += count * g_nodeKeys;
+    }
+
+    m_nodes.assign(total, std::numeric_limits<int>::max());
+
+    // leaves: the keys, padded
+    const std::size_t height { counts.size() };
+    std::copy(sorted.begin(), sorted.end(), m_nodes.begin() + static_cast<std::ptrdiff_t>(m_levelOffsets[height - 1]));
+
+    // internal levels: key j of a node is the last key of child j, whose subtree covers
+    // childSpan leaf keys; empty children keep INT_MAX
+    std::size_t childSpan { g_nodeKeys };
+    for (std::size_t level { height - 1 }; level-- > 0;)
+    {
+        for (std::size_t node { 0 }; node < counts[level]; ++node)
+        {
+            for (std::size_t j { 0 }; j < g_nodeKeys; ++j)
+            {
+                std::size_t first { (node * g_fanOut + j) * childSpan };
+                if (first >= m_size)
+                {
+                    break;
+                }
+
+                std::size_t last { std::min(first + childSpan, m_size) - 1 };
+                m_nodes[m_levelOffsets[level] + node * g_nodeKeys + j] = sorted[last];
+            }
+        }
+
+        childSpan *= g_fanOut;
+    }
+}
+
+int STreeIndex::lowerBound(int target) const
+{
+    std::size_t position { };
+
+#ifdef CPUFEATURES_X86
+    if (hasAvx2())
+    {
+        position = lowerBoundAvx2(m_nodes.data(), m_levelOffsets.data(), m_levelNodes.data(), m_levelNodes.size(), target);
+    }
+    else
+#endif
+    {
+        position = lowerBoundScalar(m_nodes.data(), m_levelOffsets.data(), m_levelNodes.data(), m_levelNodes.size(), target);
+    }
+
+    // the padding after the last key is INT_MAX, which can count as >= target
+    return static_cast<int>(std::min(position, m_size));
+}
+
+int STreeIndex::find(int target) const
+{
+    int position { lowerBound(target) };
+    const std::size_t leaves { m_levelOffsets.back() };
+
+    return (position != getSize() && m_nodes[leaves + static_cast<std::size_t>(position)] == target) ? position : -1;
+}
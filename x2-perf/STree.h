@@ -0,0 +1,41 @@
+#ifndef STREE_H
+#define STREE_H
+
+#include "AlignedAllocator.h"
+
+#include <cstddef> // for std::size_t
+#include <span>
+#include <vector>
+
+inline constexpr int g_sTreeNodeKeys { 16 };
+
+// Read-only static B+ tree ("S-tree") over sorted keys. Every node is 16 keys, one 64-byte cache
+// line. The leaves are the sorted keys themselves; key j of an internal node is the largest key
+// under child j and child 16 takes the rest, so a node is searched by counting its keys < target
+// (two AVX2 compares and a movemask when available) and a lookup costs about log17(n) cache
+// misses instead of log2(n).
+//
+// Levels are stored root first, each padded to whole nodes with INT_MAX.
+class STreeIndex
+{
+private:
+    std::vector<int, AlignedAllocator<int, 64>> m_nodes { };
+    std::vector<std::size_t> m_levelOffsets { }; // first key of every level, root first
+    std::vector<std::size_t> m_levelNodes { };   // node count of every level
+    std::size_t m_size { };
+
+public:
+    explicit STreeIndex(std::span<const int> sorted);
+
+    int find(int target) const;
+    int lowerBound(int target) const; // sorted index of the first key >= target, or size
+
+    int getSize() const { return static_cast<int>(m_size); }
+    int getHeight() const { return static_cast<int>(m_levelNodes.size()); }
+
+    // the whole index, and how much of it is on top of the sorted keys (internal nodes + padding)
+    std::size_t getMemoryBytes() const { return m_nodes.size() * sizeof(int); }
+    std::size_t getOverheadBytes() const { return getMemoryBytes() - m_size * sizeof(int); }
+};
+
+#endif
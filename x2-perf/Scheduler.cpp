@@ -0,0 +1,157 @@
+#include "Scheduler.h"
+
+namespace
+{
+    // failed rounds over all deques before an idle worker parks
+    constexpr int g_idleRounds { 64 };
+
+    // xorshift32 per thread, for picking the first victim
+    std::uint32_t nextVictim()
+    {
+        thread_local std::uint32_t state { 0x2545f491u ^ static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(&state)) };
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+}
+
+thread_local Scheduler::Worker Scheduler::s_worker { };
+
+Scheduler::Scheduler(unsigned threadCount)
+    : m_threadCount { std::max(1u, threadCount) }
+    , m_deques { std::make_unique<WorkDeque<Task>[]>(m_threadCount) }
+    , m_previousWorker { s_worker }
+{
+    s_worker = { this, 0 };
+
+    m_threads.reserve(m_threadCount - 1);
+    for (unsigned i { 1 }; i < m_threadCount; ++i)
+    {
+        m_threads.emplace_back([this, i]() { runWorker(i); });
+    }
+}
+
+Scheduler::~Scheduler()
+{
+    m_stop.store(true, std::memory_order_seq_cst);
+    m_wakeups.fetch_add(1, std::memory_order_seq_cst);
+    m_wakeups.notify_all();
+    m_threads.clear();
+
+    s_worker = m_previousWorker;
+}
+
+void Scheduler::push(Task* task)
+{
+    m_deques[getWorkerIndex()].push(task);
+
+    // pairs with park(): either the parked worker sees the task, or we see it parked
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_parked.load(std::memory_order_seq_cst) > 0)
+    {
+        m_wakeups.fetch_add(1, std::memory_order_seq_cst);
+        m_wakeups.notify_one();
+    }
+}
+
+Scheduler::Task* Scheduler::findTask(unsigned index)
+{
+    if (Task* task { m_deques[index].pop() })
+    {
+        return task;
+    }
+
+    const unsigned first { nextVictim() % m_threadCount };
+    for (unsigned i { 0 }; i < m_threadCount; ++i)
+    {
+        const unsigned victim { (first + i) % m_threadCount };
+        if (victim == index)
+        {
+            continue;
+        }
+
+        if (Task* task { m_deques[victim].steal() })
+        {
+            return task;
+        }
+    }
+
+    return nullptr;
+}
+
+bool Scheduler::hasWork() const
+{
+    for (unsigned i { 0 }; i < m_threadCount; ++i)
+    {
+        if (!m_deques[i].isEmpty())
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void Scheduler::execute(Task* task)
+{
+    TaskGroup* group { task->group };
+    task->run();
+    delete task;
+
+    group->m_pending.fetch_sub(1, std::memory_order_release);
+}
+
+void Scheduler::park()
+{
+    m_parked.fetch_add(1, std::memory_order_seq_cst);
+    const std::uint32_t wakeups { m_wakeups.load(std::memory_order_seq_cst) };
+
+    if (!hasWork() && !m_stop.load(std::memory_order_seq_cst))
+    {
+        m_wakeups.wait(wakeups, std::memory_order_seq_cst);
+    }
+
+    m_parked.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void Scheduler::runWorker(unsigned index)
+{
+    s_worker = { this, index };
+
+    int idleRounds { 0 };
+    while (!m_stop.load(std::memory_order_acquire))
+    {
+        if (Task* task { findTask(index) })
+        {
+            execute(task);
+            idleRounds = 0;
+        }
+        else if (++idleRounds < g_idleRounds)
+        {
+            std::this_thread::yield();
+        }
+        else
+        {
+            park();
+            idleRounds = 0;
+        }
+    }
+}
+
+void Scheduler::sync(TaskGroup& group)
+{
+    const unsigned index { getWorkerIndex() };
+
+    while (group.m_pending.load(std::memory_order_acquire) != 0)
+    {
+        if (Task* task { findTask(index) })
+        {
+            execute(task);
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+}
@@ -0,0 +1,164 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include "Threads.h"
+#include "WorkDeque.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint32_t
+#include <memory> // for std::unique_ptr
+#include <thread>
+#include <type_traits> // for std::decay_t
+#include <utility> // for std::forward, std::move
+#include <vector>
+
+// Tasks spawned into a group; sync(group) returns once all of them have run
+class TaskGroup
+{
+private:
+    std::atomic<std::size_t> m_pending { 0 };
+
+    friend class Scheduler;
+
+public:
+    TaskGroup() = default;
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    ~TaskGroup()
+    {
+        assert(m_pending.load() == 0 && "TaskGroup destroyed before sync");
+    }
+};
+
+// Work-stealing task scheduler: every worker has a WorkDeque, spawns push onto the spawning
+// worker's own deque and idle workers steal the oldest task of a random other worker, so there
+// is no shared queue (or lock) on the spawn path. Workers that find nothing to steal for a while
+// park on an atomic and are woken by the next spawn.
+//
+// Like runOnThreads, the thread that creates the scheduler is worker 0 and helps run tasks while
+// it waits in sync; threadCount - 1 more threads are started. spawn, sync and parallelFor may
+// only be called from worker threads, i.e. the creating thread and from inside tasks. Tasks must
+// not throw.
+class Scheduler
+{
+private:
+    class Task
+    {
+    public:
+        TaskGroup* group { };
+
+        explicit Task(TaskGroup* taskGroup)
+            : group { taskGroup }
+        {
+        }
+
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+        virtual ~Task() = default;
+
+        virtual void run() = 0;
+    };
+
+    template <typename Function>
+    class FunctionTask : public Task
+    {
+    private:
+        Function m_function;
+
+    public:
+        FunctionTask(TaskGroup* group, Function function)
+            : Task { group }
+            , m_function { std::move(function) }
+        {
+        }
+
+        void run() override
+        {
+            m_function();
+        }
+    };
+
+    unsigned m_threadCount { };
+    std::unique_ptr<WorkDeque<Task>[]> m_deques { };
+    std::atomic<bool> m_stop { false };
+    std::atomic<std::uint32_t> m_wakeups { 0 }; // parked workers wait for this to change
+    std::atomic<unsigned> m_parked { 0 };
+
+    // the worker running on this thread, if it belongs to a scheduler
+    struct Worker
+    {
+        Scheduler* scheduler { };
+        unsigned index { };
+    };
+
+    static thread_local Worker s_worker;
+
+    Worker m_previousWorker { }; // of the creating thread, restored on destruction
+    std::vector<std::jthread> m_threads { }; // last, so they are joined before the rest goes
+
+    unsigned getWorkerIndex() const
+    {
+        assert(s_worker.scheduler == this && "Only worker threads of this scheduler can spawn or sync");
+        return s_worker.index;
+    }
+
+    void push(Task* task);
+    Task* findTask(unsigned index);
+    bool hasWork() const;
+    void execute(Task* task);
+    void park();
+    void runWorker(unsigned index);
+
+public:
+    explicit Scheduler(unsigned threadCount = getHardwareThreads());
+    ~Scheduler();
+
+    Scheduler(const Scheduler&) = delete;
+    Scheduler& operator=(const Scheduler&) = delete;
+
+    // Runs function() on some worker as part of group
+    template <typename Function>
+    void spawn(TaskGroup& group, Function&& function)
+    {
+        group.m_pending.fetch_add(1, std::memory_order_relaxed);
+        push(new FunctionTask<std::decay_t<Function>> { &group, std::forward<Function>(function) });
+    }
+
+    // Runs tasks (of any group) until every task of group has finished
+    void sync(TaskGroup& group);
+
+    // Calls function(first, last) over ranges of at most grain indexes that together cover
+    // [begin, end). The range is halved recursively and one half spawned each time, so idle
+    // workers steal big pieces first. grain = 0 picks about 8 pieces per worker.
+    template <typename Function>
+    void parallelFor(std::size_t begin, std::size_t end, std::size_t grain, const Function& function)
+    {
+        if (grain == 0)
+        {
+            grain = std::max<std::size_t>(1, (end - begin) / (8 * std::size_t { m_threadCount }));
+        }
+
+        TaskGroup group { };
+        while (end - begin > grain)
+        {
+            const std::size_t middle { begin + (end - begin) / 2 };
+            spawn(group, [this, middle, end, grain, &function]() { parallelFor(middle, end, grain, function); });
+            end = middle;
+        }
+
+        if (begin < end)
+        {
+            function(begin, end);
+        }
+
+        sync(group);
+    }
+
+    unsigned getThreadCount() const { return m_threadCount; }
+};
+
+#endif
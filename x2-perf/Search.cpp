@@ -0,0 +1,179 @@
+#include "Search.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef> // for std::size_t
+
+int branchlessSearch(const int* array, int size, int target)
+{
+    if (size <= 0)
+    {
+        return -1;
+    }
+
+    const int* base { array };
+    int length { size };
+
+    while (length > 1)
+    {
+        int half { length / 2 };
+
+        __builtin_prefetch(base + half / 2);
+        __builtin_prefetch(base + half + half / 2);
+
+        base = (base[half] < target) ? base + half : base;
+        length -= half;
+    }
+
+    // base is the last element < target (or the first element); the answer is here or next
+    const int* lowerBound { base + (*base < target) };
+
+    return (lowerBound != array + size && *lowerBound == target) ? static_cast<int>(lowerBound - array) : -1;
+}
+
+namespace
+{
+    // Searches count (<= g_batchWidth) queries in lockstep
+    void searchBatch(std::span<const int> keys, const int* queries, int* results, int count)
+    {
+        const int* bases[g_batchWidth];
+        for (int i { 0 }; i < count; ++i)
+        {
+            bases[i] = keys.data();
+        }
+
+        auto length { static_cast<std::ptrdiff_t>(keys.size()) };
+        while (length > 1)
+        {
+            std::ptrdiff_t half { length / 2 };
+            std::ptrdiff_t nextHalf { (length - half) / 2 };
+
+            for (int i { 0 }; i < count; ++i)
+            {
+                bases[i] = (bases[i][half] < queries[i]) ? bases[i] + half : bases[i];
+                __builtin_prefetch(bases[i] + nextHalf);
+            }
+
+            length -= half;
+        }
+
+        for (int i { 0 }; i < count; ++i)
+        {
+            const int* lowerBound { bases[i] + (*bases[i] < queries[i]) };
+            bool found { lowerBound != keys.data() + keys.size() && *lowerBound == queries[i] };
+
+            results[i] = found ? static_cast<int>(lowerBound - keys.data()) : -1;
+        }
+    }
+
+    void searchSorted(std::span<const int> keys, std::span<const int> queries, std::span<int> results)
+    {
+        auto position { keys.begin() };
+
+        for (std::size_t i { 0 }; i < queries.size(); ++i)
+        {
+            const int query { queries[i] };
+
+            // gallop: 1, 2, 4, ... keys ahead until we pass the query, then binary search that gap
+            std::ptrdiff_t step { 1 };
+            auto low { position };
+            while (keys.end() - position > step && *(position + step) < query)
+            {
+                low = position + step;
+                step *= 2;
+            }
+
+            auto high { (keys.end() - position > step) ? position + step + 1 : keys.end() };
+            position = std::lower_bound(low, high, query);
+
+            bool found { position != keys.end() && *position == query };
+            results[i] = found ? static_cast<int>(position - keys.begin()) : -1;
+        }
+    }
+}
+
+void batchSearch(std::span<const int> keys, std::span<const int> queries, std::span<int> results)
+{
+    assert(results.size() >= queries.size() && "Not enough room for the results");
+
+    if (keys.empty())
+    {
+        std::fill(results.begin(), results.begin() + static_cast<std::ptrdiff_t>(queries.size()), -1);
+        return;
+    }
+
+    if (std::is_sorted(queries.begin(), queries.end()))
+    {
+        searchSorted(keys, queries, results);
+        return;
+    }
+
+    for (std::size_t first { 0 }; first < queries.size(); first += g_batchWidth)
+    {
+        int count { static_cast<int>(std::min<std::size_t>(g_batchWidth, queries.size() - first)) };
+        searchBatch(keys, queries.data() + first, results.data() + first, count);
+    }
+}
+
+EytzingerIndex::EytzingerIndex(std::span<const int> sorted)
+    : m_keys(sorted.size() + 1), m_positions(sorted.size() + 1)
+{
+    const std::size_t size { sorted.size() };
+    assert(std::is_sorted(sorted.begin(), sorted.end()) && "Eytzinger index needs sorted keys");
+
+    // an in-order walk of the implicit tree visits the nodes in sorted order
+    std::size_t next { 0 };
+    std::size_t node { 1 };
+    std::vector<std::size_t> stack { };
+
+    while (node <= size || !stack.empty())
+    {
+        while (node <= size)
+        {
+            stack.push_back(node);
+            node *= 2;
+        }
+
+        node = stack.back();
+        stack.pop_back();
+
+        m_keys[node] = sorted[next];
+        m_positions[node] = static_cast<int>(next);
+        ++next;
+
+        node = 2 * node + 1;
+    }
+}
+
+int EytzingerIndex::findNode(int target) const
+{
+    const std::size_t size { m_keys.size() - 1 };
+    const std::size_t lastLine { (m_keys.size() - 1) & ~std::size_t { 15 } };
+    std::size_t node { 1 };
+
+    while (node <= size)
+    {
+        __builtin_prefetch(m_keys.data() + std::min(16 * node, lastLine));
+        node = 2 * node + static_cast<std::size_t>(m_keys[node] < target);
+    }
+
+    // node went right every time it saw a key < target and left otherwise; dropping the
+    // trailing right turns plus one left turn gives the last node that went left (or 0)
+    node >>= __builtin_ffsll(static_cast<long long>(~node));
+
+    return static_cast<int>(node);
+}
+
+int EytzingerIndex::find(int target) const
+{
+    int node { findNode(target) };
+
+    return (node != 0 && m_keys[static_cast<std::size_t>(node)] == target) ? m_positions[static_cast<std::size_t>(node)] : -1;
+}
+
+int EytzingerIndex::lowerBound(int target) const
+{
+    int node { findNode(target) };
+
+    return (node != 0) ? m_positions[static_cast<std::size_t>(node)] : getSize();
+}
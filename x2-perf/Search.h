@@ -0,0 +1,49 @@
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include "AlignedAllocator.h"
+
+#include <span>
+#include <vector>
+
+// Faster lookups in a sorted int array with the same result as binarySearch: the index of the
+// target, or -1 if it is not there (with duplicates, the first one).
+
+// No branch on the comparison: every step halves the range with a conditional move, so there is
+// nothing to mispredict. Both possible next probes are prefetched while the current one loads.
+int branchlessSearch(const int* array, int size, int target);
+
+// Looks up many queries at once: results[i] = the index of queries[i] in keys, or -1.
+//
+// Unsorted queries are searched g_batchWidth at a time in lockstep (branchless halving, all
+// searches in a batch share the same remaining length). After each step the exact next probe
+// of every search is prefetched, and the other searches of the batch run while it loads, so
+// up to g_batchWidth cache misses are in flight instead of one.
+//
+// If the queries are sorted, a single merge-style scan over keys answers all of them: each query
+// gallops forward from where the previous one ended.
+inline constexpr int g_batchWidth { 16 };
+
+void batchSearch(std::span<const int> keys, std::span<const int> queries, std::span<int> results);
+
+// The same keys stored in Eytzinger (BFS) order: node k has children 2k and 2k + 1, so the first
+// levels of every search share a handful of cache lines, and the 16 nodes four levels below k
+// sit in one 64-byte line that can be prefetched before it is needed.
+class EytzingerIndex
+{
+private:
+    std::vector<int, AlignedAllocator<int, 64>> m_keys { }; // 1-based, m_keys[0] unused
+    std::vector<int> m_positions { };                       // sorted index of every node
+
+    int findNode(int target) const; // node of the first key >= target, 0 if there is none
+
+public:
+    explicit EytzingerIndex(std::span<const int> sorted);
+
+    int find(int target) const;
+    int lowerBound(int target) const; // sorted index of the first key >= target, or size
+
+    int getSize() const { return static_cast<int>(m_positions.size()) - 1; }
+};
+
+#endif
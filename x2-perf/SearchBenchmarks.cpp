@@ -0,0 +1,410 @@
+#include "ClassicSearch.h"
+#include "LearnedIndex.h"
+#include "Search.h"
+#include "STree.h"
+#include "StaticSearch.h"
+#include "Suites.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint> // for std::int64_t
+#include <limits>
+#include <memory> // for std::shared_ptr, std::unique_ptr
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // odd:       1, 3, 5, ..., queries uniform over [0, 2 * size], so even ones miss
+    // uniform:   random gaps of 1 to g, as evenly spread as the int range allows
+    // clustered: runs of 1 to 64 consecutive keys between random jumps, hard to fit with few lines
+    // For the last two, half of the queries are keys and half are random values in their range.
+    enum class KeyPattern
+    {
+        odd,
+        uniform,
+        clustered,
+    };
+
+    // Only the current size and pattern are kept in memory (plus their indexes), so 1 GB arrays
+    // don't pile up.
+    class SearchFixture
+    {
+    private:
+        SuiteOptions m_options { };
+        std::size_t m_size { };
+        KeyPattern m_pattern { };
+        bool m_hasData { false };
+
+        void generateKeys(std::mt19937_64& mt)
+        {
+            const std::size_t size { keys.size() };
+
+            if (m_pattern == KeyPattern::odd)
+            {
+                for (std::size_t i { 0 }; i < size; ++i)
+                {
+                    keys[i] = static_cast<int>(2 * i + 1);
+                }
+
+                return;
+            }
+
+            // mean gap <= g keeps the last key inside the int range; 16 * g is computed in 64 bits
+            // (it overflows int for tiny sizes), and a jump that would leave no room for the keys
+            // still to come is cut short
+            constexpr int maxKey { std::numeric_limits<int>::max() };
+            const int g { static_cast<int>(maxKey / (size + 1)) };
+            std::uniform_int_distribution<int> gap { 1, std::max(g, 1) };
+            std::uniform_int_distribution<int> run { 1, 64 };
+            const auto maxJump { std::clamp<std::int64_t>(std::int64_t { 16 } * g, 1, maxKey) };
+            std::uniform_int_distribution<int> jump { 1, static_cast<int>(maxJump) };
+
+            int key { 0 };
+            int runLeft { 0 };
+            for (std::size_t i { 0 }; i < size; ++i)
+            {
+                if (m_pattern == KeyPattern::uniform)
+                {
+                    key += gap(mt);
+                }
+                else if (runLeft-- == 0)
+                {
+                    runLeft = run(mt);
+                    const std::int64_t keyLimit { maxKey - static_cast<std::int64_t>(size - i) + 1 };
+                    key = static_cast<int>(std::min(std::int64_t { key } + jump(mt), keyLimit));
+                }
+                else
+                {
+                    ++key;
+                }
+
+                keys[i] = key;
+            }
+        }
+
+        void generateQueries(std::mt19937_64& mt)
+        {
+            queries.resize(m_options.queries);
+
+            if (m_pattern == KeyPattern::odd || keys.empty())
+            {
+                std::uniform_int_distribution<int> die { 0, static_cast<int>(2 * keys.size()) };
+                std::generate(queries.begin(), queries.end(), [&]() { return die(mt); });
+                return;
+            }
+
+            std::uniform_int_distribution<std::size_t> index { 0, keys.size() - 1 };
+            std::uniform_int_distribution<int> value { 0, keys.back() };
+            for (std::size_t i { 0 }; i < queries.size(); ++i)
+            {
+                queries[i] = (i % 2 == 0) ? keys[index(mt)] : value(mt);
+            }
+        }
+
+    public:
+        std::vector<int> keys { };
+        std::vector<int> queries { };
+        std::vector<int> expected { };
+        std::vector<int> sortedQueries { };
+        std::vector<int> sortedExpected { };
+        std::vector<int> results { };
+        std::unique_ptr<EytzingerIndex> eytzinger { };
+        std::unique_ptr<STreeIndex> sTree { };
+        std::unique_ptr<LearnedIndex> learned { };
+
+        explicit SearchFixture(const SuiteOptions& options)
+            : m_options { options }
+        {
+        }
+
+        void prepare(std::size_t size, KeyPattern pattern = KeyPattern::odd)
+        {
+            if (m_hasData && m_size == size && m_pattern == pattern)
+            {
+                return;
+            }
+
+            eytzinger.reset();
+            sTree.reset();
+            learned.reset();
+            keys.clear();
+            keys.shrink_to_fit();
+
+            m_pattern = pattern;
+            keys.resize(size);
+
+            std::mt19937_64 mt { m_options.seed };
+            generateKeys(mt);
+            generateQueries(mt);
+
+            expected.resize(queries.size());
+            for (std::size_t i { 0 }; i < queries.size(); ++i)
+            {
+                auto found { std::lower_bound(keys.begin(), keys.end(), queries[i]) };
+                expected[i] = (found != keys.end() && *found == queries[i]) ? static_cast<int>(found - keys.begin()) : -1;
+            }
+
+            sortedQueries = queries;
+            std::sort(sortedQueries.begin(), sortedQueries.end());
+            sortedExpected.resize(sortedQueries.size());
+            for (std::size_t i { 0 }; i < sortedQueries.size(); ++i)
+            {
+                auto found { std::lower_bound(keys.begin(), keys.end(), sortedQueries[i]) };
+                sortedExpected[i] = (found != keys.end() && *found == sortedQueries[i]) ? static_cast<int>(found - keys.begin()) : -1;
+            }
+
+            results.assign(queries.size(), 0);
+
+            m_size = size;
+            m_hasData = true;
+        }
+
+        EytzingerIndex& getEytzinger()
+        {
+            if (!eytzinger)
+            {
+                eytzinger = std::make_unique<EytzingerIndex>(keys);
+            }
+
+            return *eytzinger;
+        }
+
+        STreeIndex& getSTree()
+        {
+            if (!sTree)
+            {
+                sTree = std::make_unique<STreeIndex>(keys);
+            }
+
+            return *sTree;
+        }
+
+        LearnedIndex& getLearned()
+        {
+            if (!learned)
+            {
+                learned = std::make_unique<LearnedIndex>(keys);
+            }
+
+            return *learned;
+        }
+
+        bool check() const
+        {
+            return results == expected;
+        }
+
+        bool checkSorted() const
+        {
+            return results == sortedExpected;
+        }
+    };
+
+    using SearchFn = int (*)(SearchFixture& fixture, int target);
+
+    struct SearchAlgorithm
+    {
+        std::string_view name { };
+        SearchFn search { };
+    };
+
+    struct SearchKeys
+    {
+        std::string_view group { };
+        KeyPattern pattern { };
+    };
+
+    constexpr SearchKeys g_searchKeys[] {
+        { "search", KeyPattern::odd },
+        { "search-uniform", KeyPattern::uniform },
+        { "search-clustered", KeyPattern::clustered },
+    };
+
+    constexpr SearchAlgorithm g_searchAlgorithms[] {
+        { "binarySearch",
+            [](SearchFixture& f, int target)
+            {
+                return binarySearch(f.keys.data(), target, 0, static_cast<int>(f.keys.size()) - 1);
+            } },
+        { "binarySearchRec",
+            [](SearchFixture& f, int target)
+            {
+                return binarySearchRec(f.keys.data(), target, 0, static_cast<int>(f.keys.size()) - 1);
+            } },
+        { "branchlessSearch",
+            [](SearchFixture& f, int target)
+            {
+                return branchlessSearch(f.keys.data(), static_cast<int>(f.keys.size()), target);
+            } },
+        { "EytzingerIndex", [](SearchFixture& f, int target) { return f.eytzinger->find(target); } },
+        { "STreeIndex", [](SearchFixture& f, int target) { return f.sTree->find(target); } },
+        { "LearnedIndex", [](SearchFixture& f, int target) { return f.learned->find(target); } },
+    };
+
+    // Fixed tables for StaticSearch.h: the array from 08_binary_search.cpp and the HTTP status
+    // codes as an enum-like table
+    constexpr std::array g_exerciseKeys { 3, 6, 8, 12, 14, 17, 20, 21, 26, 32, 36, 37, 42, 44, 48 };
+
+    constexpr std::array g_httpStatusCodes {
+        100, 101, 102, 103, 200, 201, 202, 203, 204, 205, 206, 207, 208, 226, 300, 301, 302, 303,
+        304, 305, 307, 308, 400, 401, 402, 403, 404, 405, 406, 407, 408, 409, 410, 411, 412, 413,
+        414, 415, 416, 417, 418, 421, 422, 423, 424, 425, 426, 428, 429, 431, 451, 500, 501, 502,
+        503, 504, 505, 506, 507, 508, 510, 511,
+    };
+
+    static_assert(treeSearch<g_exerciseKeys>(3) == 0 && treeSearch<g_exerciseKeys>(48) == 14);
+    static_assert(treeSearch<g_exerciseKeys>(13) == -1 && treeSearch<g_exerciseKeys>(49) == -1);
+    static_assert(perfectHashSearch<g_exerciseKeys>(26) == 8 && perfectHashSearch<g_exerciseKeys>(0) == -1);
+    static_assert(staticSearch(g_exerciseKeys, 44) == 13 && staticSearch(g_exerciseKeys, 43) == -1);
+    static_assert(perfectHashSearch<g_httpStatusCodes>(404) == 26 && perfectHashSearch<g_httpStatusCodes>(499) == -1);
+    static_assert(treeSearch<g_httpStatusCodes>(511) == 61 && staticSearch(g_httpStatusCodes, 100) == 0);
+
+    // Queries are uniform over [first key - 1, last key + 1], so most of them miss
+    template <std::array Keys>
+    void addStaticSearchCases(BenchmarkSuite& suite, const SuiteOptions& options, const std::string& table)
+    {
+        using StaticFn = int (*)(int target);
+
+        struct StaticAlgorithm
+        {
+            std::string_view name { };
+            StaticFn search { };
+        };
+
+        constexpr StaticAlgorithm algorithms[] {
+            { "binarySearch", [](int target) { return binarySearch(Keys.data(), target, 0, static_cast<int>(Keys.size()) - 1); } },
+            { "staticSearch", [](int target) { return staticSearch(Keys, target); } },
+            { "treeSearch", [](int target) { return treeSearch<Keys>(target); } },
+            { "perfectHashSearch", [](int target) { return perfectHashSearch<Keys>(target); } },
+        };
+
+        struct Data
+        {
+            std::vector<int> queries { };
+            std::vector<int> expected { };
+            std::vector<int> results { };
+        };
+
+        auto data { std::make_shared<Data>() };
+
+        std::mt19937_64 mt { options.seed };
+        std::uniform_int_distribution<int> die { Keys.front() - 1, Keys.back() + 1 };
+        data->queries.resize(options.queries);
+        std::generate(data->queries.begin(), data->queries.end(), [&]() { return die(mt); });
+
+        for (int query : data->queries)
+        {
+            auto found { std::lower_bound(Keys.begin(), Keys.end(), query) };
+            data->expected.push_back((found != Keys.end() && *found == query) ? static_cast<int>(found - Keys.begin()) : -1);
+        }
+
+        data->results.resize(data->queries.size());
+
+        for (const auto& algorithm : algorithms)
+        {
+            auto search { algorithm.search };
+
+            suite.add({
+                "search-static/" + table, std::string { algorithm.name },
+                { },
+                [data, search]()
+                {
+                    for (std::size_t i { 0 }; i < data->queries.size(); ++i)
+                    {
+                        data->results[i] = search(data->queries[i]);
+                    }
+                },
+                [data]() { return data->results == data->expected; },
+                static_cast<double>(options.queries), 0.0,
+            });
+        }
+    }
+}
+
+void addSearchCases(BenchmarkSuite& suite, const SuiteOptions& options)
+{
+    auto fixture { std::make_shared<SearchFixture>(options) };
+
+    for (std::size_t size { options.minSize }; size <= options.maxSize; size *= 10)
+    {
+        for (const auto& searchKeys : g_searchKeys)
+        {
+            const std::string group { std::string { searchKeys.group } + "/" + std::to_string(size) };
+            const KeyPattern pattern { searchKeys.pattern };
+
+            for (const auto& algorithm : g_searchAlgorithms)
+            {
+                auto search { algorithm.search };
+
+                suite.add({
+                    group, std::string { algorithm.name },
+                    [fixture, size, pattern]()
+                    {
+                        fixture->prepare(size, pattern);
+                        fixture->getEytzinger();
+                        fixture->getSTree();
+                        fixture->getLearned();
+                    },
+                    [fixture, search]()
+                    {
+                        for (std::size_t i { 0 }; i < fixture->queries.size(); ++i)
+                        {
+                            fixture->results[i] = search(*fixture, fixture->queries[i]);
+                        }
+                    },
+                    [fixture]() { return fixture->check(); },
+                    static_cast<double>(options.queries), 0.0,
+                });
+            }
+
+            suite.add({
+                group, "batchSearch",
+                [fixture, size, pattern]() { fixture->prepare(size, pattern); },
+                [fixture]() { batchSearch(fixture->keys, fixture->queries, fixture->results); },
+                [fixture]() { return fixture->check(); },
+                static_cast<double>(options.queries), 0.0,
+            });
+
+            if (pattern != KeyPattern::odd)
+            {
+                continue;
+            }
+
+            // the same queries in ascending order: one at a time vs. a single merge-style scan
+            const std::string sortedGroup { "search-sorted/" + std::to_string(size) };
+
+            suite.add({
+                sortedGroup, "branchlessSearch",
+                [fixture, size]() { fixture->prepare(size); },
+                [fixture]()
+                {
+                    for (std::size_t i { 0 }; i < fixture->sortedQueries.size(); ++i)
+                    {
+                        fixture->results[i] = branchlessSearch(fixture->keys.data(), static_cast<int>(fixture->keys.size()), fixture->sortedQueries[i]);
+                    }
+                },
+                [fixture]() { return fixture->checkSorted(); },
+                static_cast<double>(options.queries), 0.0,
+            });
+
+            suite.add({
+                sortedGroup, "batchSearch",
+                [fixture, size]() { fixture->prepare(size); },
+                [fixture]() { batchSearch(fixture->keys, fixture->sortedQueries, fixture->results); },
+                [fixture]() { return fixture->checkSorted(); },
+                static_cast<double>(options.queries), 0.0,
+            });
+        }
+
+        if (size == 0)
+        {
+            break;
+        }
+    }
+
+    addStaticSearchCases<g_exerciseKeys>(suite, options, "08_binary_search");
+    addStaticSearchCases<g_httpStatusCodes>(suite, options, "httpStatusCodes");
+}
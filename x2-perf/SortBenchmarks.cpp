@@ -0,0 +1,253 @@
+#include "AdaptiveSort.h"
+#include "ClassicSorts.h"
+#include "InputGenerators.h"
+#include "IntroSort.h"
+#include "ParallelSort.h"
+#include "RadixSort.h"
+#include "SortingNetworks.h"
+#include "Suites.h"
+
+#include <algorithm>
+#include <memory> // for std::shared_ptr
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    struct SortAlgorithm
+    {
+        std::string_view name { };
+        bool quadratic { };        // skipped above SuiteOptions::quadraticMaxSize
+        void (*sort)(std::span<int>) { };
+    };
+
+    constexpr SortAlgorithm g_sortAlgorithms[] {
+        { "sortArray", true, sortArray },
+        { "selectionSort", true,
+            [](std::span<int> array) { selectionSort(array.data(), static_cast<int>(array.size())); } },
+        { "selectionSort<lambda>", true,
+            [](std::span<int> array)
+            {
+                selectionSort(array.data(), static_cast<int>(array.size()),
+                    [](int x, int y) { return ascending(x, y); });
+            } },
+        { "bubbleSort", true, bubbleSort },
+        { "std::sort", false, [](std::span<int> array) { std::sort(array.begin(), array.end()); } },
+        { "radixSort", false, [](std::span<int> array) { radixSort(array); } },
+        { "adaptiveSort", false, [](std::span<int> array) { adaptiveSort(array); } },
+        { "introSort", false, [](std::span<int> array) { introSort(array); } },
+        { "parallelSort", false, [](std::span<int> array) { parallelSort(array, getHardwareThreads()); } },
+    };
+
+    // Holds only the input of the current group, so 1e8-element matrices don't keep every
+    // distribution in memory at once. Cases of one group run back to back, so each input is
+    // generated once.
+    class SortFixture
+    {
+    private:
+        SuiteOptions m_options { };
+        Distribution m_distribution { };
+        std::size_t m_size { };
+        bool m_hasInput { false };
+        std::vector<int> m_input { };
+
+    public:
+        std::vector<int> work { };
+
+        explicit SortFixture(const SuiteOptions& options)
+            : m_options { options }
+        {
+        }
+
+        const std::vector<int>& getInput(Distribution distribution, std::size_t size)
+        {
+            if (!m_hasInput || m_distribution != distribution || m_size != size)
+            {
+                m_input.clear();
+                m_input.shrink_to_fit();
+                m_input = generateInput(distribution, size, m_options.seed, m_options.swaps);
+                m_distribution = distribution;
+                m_size = size;
+                m_hasInput = true;
+            }
+
+            return m_input;
+        }
+    };
+
+    // count arrays of N elements each; row-major for the one-array-at-a-time sorts,
+    // column-major for sortColumns
+    template <std::size_t N>
+    void addSortSmallCases(BenchmarkSuite& suite, const std::shared_ptr<SortFixture>& fixture, std::size_t count)
+    {
+        const std::size_t size { N * count };
+        const std::string group { "sort-small/" + std::to_string(N) + "x" + std::to_string(count) };
+
+        auto rowsSorted {
+            [fixture]()
+            {
+                for (auto row { fixture->work.begin() }; row != fixture->work.end(); row += N)
+                {
+                    if (!std::is_sorted(row, row + N))
+                    {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+        };
+
+        auto columnsSorted {
+            [fixture, count]()
+            {
+                for (std::size_t column { 0 }; column < count; ++column)
+                {
+                    for (std::size_t row { 1 }; row < N; ++row)
+                    {
+                        if (fixture->work[row * count + column] < fixture->work[(row - 1) * count + column])
+                        {
+                            return false;
+                        }
+                    }
+                }
+
+                return true;
+            }
+        };
+
+        auto setup { [fixture, size]() { fixture->work = fixture->getInput(Distribution::random, size); } };
+
+        suite.add({
+            group, "std::sort", setup,
+            [fixture]()
+            {
+                for (auto row { fixture->work.begin() }; row != fixture->work.end(); row += N)
+                {
+                    std::sort(row, row + N);
+                }
+            },
+            rowsSorted, static_cast<double>(size), static_cast<double>(size * sizeof(int)),
+        });
+
+        suite.add({
+            group, "sortSmall", setup,
+            [fixture]()
+            {
+                for (std::size_t row { 0 }; row < fixture->work.size(); row += N)
+                {
+                    sortSmall(fixture->work.data() + row, N);
+                }
+            },
+            rowsSorted, static_cast<double>(size), static_cast<double>(size * sizeof(int)),
+        });
+
+        suite.add({
+            group, "sortNetwork<" + std::to_string(N) + ">", setup,
+            [fixture]()
+            {
+                for (std::size_t row { 0 }; row < fixture->work.size(); row += N)
+                {
+                    networks::sortFixed<N>(fixture->work.data() + row);
+                }
+            },
+            rowsSorted, static_cast<double>(size), static_cast<double>(size * sizeof(int)),
+        });
+
+        suite.add({
+            group, "sortColumns<" + std::to_string(N) + ">", setup,
+            [fixture, count]() { sortColumns<N>(fixture->work.data(), count); },
+            columnsSorted, static_cast<double>(size), static_cast<double>(size * sizeof(int)),
+        });
+    }
+}
+
+void addSortCases(BenchmarkSuite& suite, const SuiteOptions& options)
+{
+    auto fixture { std::make_shared<SortFixture>(options) };
+
+    for (std::size_t size { options.minSize }; size <= options.maxSize; size *= 10)
+    {
+        for (Distribution distribution : g_distributions)
+        {
+            const std::string group { "sort/" + std::string { getDistributionName(distribution) } + '/'
+                + std::to_string(size) };
+
+            for (const auto& algorithm : g_sortAlgorithms)
+            {
+                if (algorithm.quadratic && size > options.quadraticMaxSize)
+                {
+                    continue;
+                }
+
+                auto sort { algorithm.sort };
+
+                suite.add({
+                    group,
+                    std::string { algorithm.name },
+                    [fixture, distribution, size]() { fixture->work = fixture->getInput(distribution, size); },
+                    [fixture, sort]() { sort(fixture->work); },
+                    [fixture]() { return std::is_sorted(fixture->work.begin(), fixture->work.end()); },
+                    static_cast<double>(size),
+                    static_cast<double>(size * sizeof(int)),
+                });
+            }
+        }
+
+        if (size == 0)
+        {
+            break;
+        }
+    }
+}
+
+void addSortThreadsCases(BenchmarkSuite& suite, const SuiteOptions& options)
+{
+    auto fixture { std::make_shared<SortFixture>(options) };
+    auto scratch { std::make_shared<std::vector<int>>() };
+
+    for (std::size_t size { options.minSize }; size <= options.maxSize; size *= 10)
+    {
+        const std::string group { "sort-threads/random/" + std::to_string(size) };
+
+        for (unsigned threads { 1 }; threads <= options.maxThreads; threads *= 2)
+        {
+            suite.add({
+                group,
+                "parallelSort/" + std::to_string(threads) + "t",
+                [fixture, scratch, size]()
+                {
+                    fixture->work = fixture->getInput(Distribution::random, size);
+                    scratch->resize(size);
+                },
+                [fixture, scratch, threads]()
+                {
+                    parallelSort(std::span<int> { fixture->work }, std::span<int> { *scratch }, threads);
+                },
+                [fixture]() { return std::is_sorted(fixture->work.begin(), fixture->work.end()); },
+                static_cast<double>(size),
+                static_cast<double>(size * sizeof(int)),
+                threads,
+            });
+        }
+
+        if (size == 0)
+        {
+            break;
+        }
+    }
+}
+
+void addSortSmallCases(BenchmarkSuite& suite, const SuiteOptions& options)
+{
+    auto fixture { std::make_shared<SortFixture>(options) };
+
+    // roughly maxSize elements in total for every array length
+    addSortSmallCases<4>(suite, fixture, options.maxSize / 4);
+    addSortSmallCases<8>(suite, fixture, options.maxSize / 8);
+    addSortSmallCases<9>(suite, fixture, options.maxSize / 9);
+    addSortSmallCases<16>(suite, fixture, options.maxSize / 16);
+    addSortSmallCases<32>(suite, fixture, options.maxSize / 32);
+}
@@ -0,0 +1,247 @@
+#ifndef SORTINGNETWORKS_H
+#define SORTINGNETWORKS_H
+
+#include "CpuFeatures.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef> // for std::size_t
+#include <utility> // for std::index_sequence
+
+#ifdef CPUFEATURES_X86
+#include <immintrin.h>
+#endif
+
+// Sorting networks for 2..32 elements, generated at compile time (Batcher's odd-even merge sort,
+// with the comparators that would touch elements past N left out).
+//
+// A network is a fixed list of compare-exchanges, so there are no data dependent branches to
+// mispredict: every compare-exchange is a min and a max, which the compiler turns into cmov (or
+// pminsd/pmaxsd for the column versions below).
+//
+//   sortNetwork(array)          - one fixed-size array, e.g. int array[9]
+//   sortSmall(data, size)       - one array of runtime size <= g_maxNetworkSize
+//   sortColumns<N>(data, count) - count independent arrays of N ints stored column-wise
+//                                 (element r of array c at data[r * count + c]), 8 (AVX2) or
+//                                 4 (SSE4.1) arrays per instruction, scalar fallback
+
+inline constexpr std::size_t g_maxNetworkSize { 32 };
+
+struct Comparator
+{
+    unsigned char low { };
+    unsigned char high { };
+};
+
+namespace networks
+{
+    // Calls add(low, high) for every comparator of the network for size elements
+    template <typename Add>
+    constexpr void generate(std::size_t size, Add add)
+    {
+        for (std::size_t p { 1 }; p < size; p *= 2)
+        {
+            for (std::size_t k { p }; k >= 1; k /= 2)
+            {
+                for (std::size_t j { k % p }; j + k < size; j += 2 * k)
+                {
+                    for (std::size_t i { 0 }; i < k && i + j + k < size; ++i)
+                    {
+                        if ((i + j) / (2 * p) == (i + j + k) / (2 * p))
+                        {
+                            add(i + j, i + j + k);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    constexpr std::size_t getComparatorCount(std::size_t size)
+    {
+        std::size_t count { 0 };
+        generate(size, [&count](std::size_t, std::size_t) { ++count; });
+
+        return count;
+    }
+
+    template <std::size_t N>
+    constexpr auto makeNetwork()
+    {
+        std::array<Comparator, getComparatorCount(N)> network { };
+        std::size_t count { 0 };
+
+        generate(N, [&](std::size_t low, std::size_t high)
+            {
+                network[count++] = { static_cast<unsigned char>(low), static_cast<unsigned char>(high) };
+            });
+
+        return network;
+    }
+
+    template <std::size_t N>
+    inline constexpr auto g_network { makeNetwork<N>() };
+
+    template <typename T>
+    inline void compareExchange(T& low, T& high)
+    {
+        const T a { low };
+        const T b { high };
+        low = std::min(a, b);
+        high = std::max(a, b);
+    }
+
+    template <std::size_t N, typename T, std::size_t... I>
+    inline void apply(T* data, std::index_sequence<I...>)
+    {
+        (compareExchange(data[g_network<N>[I].low], data[g_network<N>[I].high]), ...);
+    }
+
+    template <std::size_t N, typename T>
+    void sortFixed(T* data)
+    {
+        if constexpr (N > 1)
+        {
+            apply<N>(data, std::make_index_sequence<g_network<N>.size()> { });
+        }
+    }
+
+    template <typename T, std::size_t... N>
+    constexpr auto makeDispatchTable(std::index_sequence<N...>)
+    {
+        return std::array<void (*)(T*), sizeof...(N)> { &sortFixed<N, T>... };
+    }
+
+    template <typename T>
+    inline constexpr auto g_dispatch { makeDispatchTable<T>(std::make_index_sequence<g_maxNetworkSize + 1> { }) };
+
+#ifdef CPUFEATURES_X86
+    __attribute__((target("avx2"))) inline void compareExchangeAvx2(__m256i& low, __m256i& high)
+    {
+        const __m256i a { low };
+        low = _mm256_min_epi32(a, high);
+        high = _mm256_max_epi32(a, high);
+    }
+
+    template <std::size_t N, std::size_t... I>
+    __attribute__((target("avx2"))) void applyAvx2(__m256i* rows, std::index_sequence<I...>)
+    {
+        (compareExchangeAvx2(rows[g_network<N>[I].low], rows[g_network<N>[I].high]), ...);
+    }
+
+    template <std::size_t N>
+    __attribute__((target("avx2"))) std::size_t sortColumnsAvx2(int* data, std::size_t count)
+    {
+        constexpr std::size_t lanes { 8 };
+        std::size_t column { 0 };
+
+        for (; column + lanes <= count; column += lanes)
+        {
+            __m256i rows[N];
+            for (std::size_t r { 0 }; r < N; ++r)
+            {
+                rows[r] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + r * count + column));
+            }
+
+            applyAvx2<N>(rows, std::make_index_sequence<g_network<N>.size()> { });
+
+            for (std::size_t r { 0 }; r < N; ++r)
+            {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + r * count + column), rows[r]);
+            }
+        }
+
+        return column;
+    }
+
+    __attribute__((target("sse4.1"))) inline void compareExchangeSse41(__m128i& low, __m128i& high)
+    {
+        const __m128i a { low };
+        low = _mm_min_epi32(a, high);
+        high = _mm_max_epi32(a, high);
+    }
+
+    template <std::size_t N, std::size_t... I>
+    __attribute__((target("sse4.1"))) void applySse41(__m128i* rows, std::index_sequence<I...>)
+    {
+        (compareExchangeSse41(rows[g_network<N>[I].low], rows[g_network<N>[I].high]), ...);
+    }
+
+    template <std::size_t N>
+    __attribute__((target("sse4.1"))) std::size_t sortColumnsSse41(int* data, std::size_t count)
+    {
+        constexpr std::size_t lanes { 4 };
+        std::size_t column { 0 };
+
+        for (; column + lanes <= count; column += lanes)
+        {
+            __m128i rows[N];
+            for (std::size_t r { 0 }; r < N; ++r)
+            {
+                rows[r] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + r * count + column));
+            }
+
+            applySse41<N>(rows, std::make_index_sequence<g_network<N>.size()> { });
+
+            for (std::size_t r { 0 }; r < N; ++r)
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(data + r * count + column), rows[r]);
+            }
+        }
+
+        return column;
+    }
+#endif
+}
+
+template <typename T, std::size_t N>
+    requires (N <= g_maxNetworkSize)
+void sortNetwork(T (&array)[N])
+{
+    networks::sortFixed<N>(array);
+}
+
+template <typename T, std::size_t N>
+    requires (N <= g_maxNetworkSize)
+void sortNetwork(std::array<T, N>& array)
+{
+    networks::sortFixed<N>(array.data());
+}
+
+template <typename T>
+void sortSmall(T* data, std::size_t size)
+{
+    assert(size <= g_maxNetworkSize && "No sorting network for this size");
+
+    networks::g_dispatch<T>[size](data);
+}
+
+template <std::size_t N>
+    requires (N >= 2 && N <= g_maxNetworkSize)
+void sortColumns(int* data, std::size_t count)
+{
+    std::size_t column { 0 };
+
+#ifdef CPUFEATURES_X86
+    if (hasAvx2())
+    {
+        column = networks::sortColumnsAvx2<N>(data, count);
+    }
+    else if (hasSse41())
+    {
+        column = networks::sortColumnsSse41<N>(data, count);
+    }
+#endif
+
+    // scalar fallback, and the columns that don't fill a whole register
+    for (; column < count; ++column)
+    {
+        for (const auto& comparator : networks::g_network<N>)
+        {
+            networks::compareExchange(data[comparator.low * count + column], data[comparator.high * count + column]);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,356 @@
+#ifndef STACK_H
+#define STACK_H
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef> // for std::byte, std::size_t
+#include <cstring> // for std::memcpy
+#include <memory> // for std::construct_at, std::destroy_at, std::destroy_n, std::uninitialized_copy_n
+#include <new> // for std::align_val_t
+#include <span>
+#include <type_traits>
+#include <utility> // for std::forward, std::move, std::exchange
+#include <vector>
+
+// Stack from 13-basic-oop/ex/01_custom_stack.cpp without the fixed CAPACITY. The first
+// InlineCapacity elements live inside the object; after that the stack grows by chunks that
+// each double the total capacity. Chunks are never reallocated, so pushing never moves an
+// existing element and pointers to elements stay valid until they are popped (elements in the
+// inline buffer do move when the Stack itself is moved). Emptied chunks are kept for the next
+// pushes until shrinkToFit() or destruction.
+template <typename T, std::size_t InlineCapacity = 16>
+class Stack
+{
+private:
+    struct Chunk
+    {
+        T* data { };
+        std::size_t capacity { };
+    };
+
+    // the first heap chunk holds about 1KB, so small elements don't start with tiny chunks
+    static constexpr std::size_t s_minChunk { std::max<std::size_t>(1, 1024 / sizeof(T)) };
+
+    alignas(T) std::array<std::byte, sizeof(T) * InlineCapacity> m_inline { };
+    std::vector<Chunk> m_chunks { }; // heap chunks; chunk index 0 is the inline buffer
+    std::size_t m_capacity { InlineCapacity };
+
+    // the chunk holding the top element; every chunk below it is full
+    std::size_t m_chunk { 0 };
+    std::size_t m_below { 0 }; // elements in the chunks below
+    T* m_begin { getData(0) };
+    T* m_top { m_begin };      // one past the top element
+    T* m_end { m_begin + InlineCapacity };
+
+    T* getData(std::size_t chunk)
+    {
+        return (chunk == 0) ? reinterpret_cast<T*>(m_inline.data()) : m_chunks[chunk - 1].data;
+    }
+
+    const T* getData(std::size_t chunk) const
+    {
+        return (chunk == 0) ? reinterpret_cast<const T*>(m_inline.data()) : m_chunks[chunk - 1].data;
+    }
+
+    std::size_t getChunkCapacity(std::size_t chunk) const
+    {
+        return (chunk == 0) ? InlineCapacity : m_chunks[chunk - 1].capacity;
+    }
+
+    void setChunk(std::size_t chunk)
+    {
+        m_chunk = chunk;
+        m_begin = getData(chunk);
+        m_end = m_begin + getChunkCapacity(chunk);
+    }
+
+    // makes sure the chunk above the current one exists, with room for at least `needed` elements
+    // if it has to be allocated, and returns its data
+    T* reserveNextChunk(std::size_t needed)
+    {
+        if (m_chunk == m_chunks.size())
+        {
+            const std::size_t capacity { std::max({ m_capacity, s_minChunk, needed }) };
+            m_chunks.reserve(m_chunks.size() + 1); // so push_back below can't throw after allocating
+
+            T* data { static_cast<T*>(::operator new(capacity * sizeof(T), std::align_val_t { alignof(T) })) };
+            m_chunks.push_back({ data, capacity });
+            m_capacity += capacity;
+        }
+
+        return m_chunks[m_chunk].data;
+    }
+
+    // called once the next element(s) are in the chunk above
+    void moveUp()
+    {
+        m_below += getChunkCapacity(m_chunk);
+        setChunk(m_chunk + 1);
+    }
+
+    // after the last element of a chunk was popped, the full chunk below holds the top again
+    void moveDownIfEmpty()
+    {
+        if (m_top == m_begin && m_chunk > 0)
+        {
+            setChunk(m_chunk - 1);
+            m_below -= getChunkCapacity(m_chunk);
+            m_top = m_end;
+        }
+    }
+
+    template <typename... Args>
+    T& emplaceInNextChunk(Args&&... args)
+    {
+        T* element { std::construct_at(reserveNextChunk(1), std::forward<Args>(args)...) };
+        moveUp();
+        m_top = element + 1;
+
+        return *element;
+    }
+
+    // calls function(data, count) for every chunk up to and including the top one
+    template <typename Function>
+    void forEachChunk(Function function) const
+    {
+        for (std::size_t chunk { 0 }; chunk < m_chunk; ++chunk)
+        {
+            function(getData(chunk), getChunkCapacity(chunk));
+        }
+
+        function(static_cast<const T*>(m_begin), static_cast<std::size_t>(m_top - m_begin));
+    }
+
+    void releaseChunks()
+    {
+        for (const Chunk& chunk : m_chunks)
+        {
+            ::operator delete(chunk.data, std::align_val_t { alignof(T) });
+        }
+
+        m_chunks.clear();
+        m_capacity = InlineCapacity;
+    }
+
+    // takes over other's elements and chunks; this must be empty and have no chunks
+    void steal(Stack& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        const auto used { other.m_top - other.m_begin };
+        const std::size_t inlineCount { (other.m_chunk == 0) ? static_cast<std::size_t>(used) : InlineCapacity };
+        T* source { other.getData(0) };
+        T* destination { getData(0) };
+        for (std::size_t i { 0 }; i < inlineCount; ++i)
+        {
+            std::construct_at(destination + i, std::move(source[i]));
+            std::destroy_at(source + i);
+        }
+
+        m_chunks = std::exchange(other.m_chunks, { });
+        m_capacity = std::exchange(other.m_capacity, InlineCapacity);
+        m_below = std::exchange(other.m_below, 0);
+        setChunk(other.m_chunk);
+        m_top = m_begin + used;
+
+        other.setChunk(0);
+        other.m_top = other.m_begin;
+    }
+
+public:
+    Stack() = default;
+
+    Stack(const Stack& other)
+    {
+        other.forEachChunk([this](const T* data, std::size_t count) { pushRange({ data, count }); });
+    }
+
+    Stack(Stack&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        steal(other);
+    }
+
+    Stack& operator=(const Stack& other)
+    {
+        if (this != &other)
+        {
+            reset();
+            other.forEachChunk([this](const T* data, std::size_t count) { pushRange({ data, count }); });
+        }
+
+        return *this;
+    }
+
+    Stack& operator=(Stack&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        if (this != &other)
+        {
+            reset();
+            releaseChunks();
+            steal(other);
+        }
+
+        return *this;
+    }
+
+    ~Stack()
+    {
+        reset();
+        releaseChunks();
+    }
+
+    // Nothing changes if the constructor throws
+    template <typename... Args>
+    T& emplace(Args&&... args)
+    {
+        if (m_top == m_end) [[unlikely]]
+        {
+            return emplaceInNextChunk(std::forward<Args>(args)...);
+        }
+
+        T* element { std::construct_at(m_top, std::forward<Args>(args)...) };
+        ++m_top;
+
+        return *element;
+    }
+
+    void push(const T& value)
+    {
+        emplace(value);
+    }
+
+    void push(T&& value)
+    {
+        emplace(std::move(value));
+    }
+
+    T pop()
+    {
+        assert(!isEmpty() && "Stack is empty");
+
+        --m_top;
+        T value { std::move(*m_top) };
+        std::destroy_at(m_top);
+        moveDownIfEmpty();
+
+        return value;
+    }
+
+    T& top()
+    {
+        assert(!isEmpty() && "Stack is empty");
+        return m_top[-1];
+    }
+
+    const T& top() const
+    {
+        assert(!isEmpty() && "Stack is empty");
+        return m_top[-1];
+    }
+
+    // Pushes values[0], values[1], ... in order, so values.back() ends on top. Copies as much as
+    // fits in the current chunk at a time, with memcpy when T is trivially copyable.
+    void pushRange(std::span<const T> values)
+    {
+        while (!values.empty())
+        {
+            const bool isFull { m_top == m_end };
+            T* destination { isFull ? reserveNextChunk(values.size()) : m_top };
+            const std::size_t room { isFull ? getChunkCapacity(m_chunk + 1) : static_cast<std::size_t>(m_end - m_top) };
+            const std::size_t count { std::min(values.size(), room) };
+
+            if constexpr (std::is_trivially_copyable_v<T>)
+            {
+                std::memcpy(destination, values.data(), count * sizeof(T));
+            }
+            else
+            {
+                std::uninitialized_copy_n(values.data(), count, destination);
+            }
+
+            if (isFull)
+            {
+                moveUp();
+            }
+
+            m_top = destination + count;
+            values = values.subspan(count);
+        }
+    }
+
+    // Pops destination.size() elements into destination, keeping their order: the old top ends
+    // up in destination.back(), so pushRange(destination) puts them back as they were
+    void popN(std::span<T> destination)
+    {
+        assert(destination.size() <= getSize() && "Not enough elements on the stack");
+
+        while (!destination.empty())
+        {
+            const std::size_t count { std::min(destination.size(), static_cast<std::size_t>(m_top - m_begin)) };
+            T* source { m_top - count };
+            T* target { destination.data() + destination.size() - count };
+            if constexpr (std::is_trivially_copyable_v<T>)
+            {
+                std::memcpy(target, source, count * sizeof(T));
+            }
+            else
+            {
+                std::move(source, m_top, target);
+                std::destroy_n(source, count);
+            }
+
+            m_top = source;
+            moveDownIfEmpty();
+            destination = destination.first(destination.size() - count);
+        }
+    }
+
+    // Calls function(element) from the bottom of the stack to the top
+    template <typename Function>
+    void forEach(Function function) const
+    {
+        forEachChunk(
+            [&function](const T* data, std::size_t count)
+            {
+                for (std::size_t i { 0 }; i < count; ++i)
+                {
+                    function(data[i]);
+                }
+            });
+    }
+
+    // Destroys every element but keeps the chunks for the next pushes
+    void reset()
+    {
+        if constexpr (!std::is_trivially_destructible_v<T>)
+        {
+            for (std::size_t chunk { 0 }; chunk < m_chunk; ++chunk)
+            {
+                std::destroy_n(getData(chunk), getChunkCapacity(chunk));
+            }
+
+            std::destroy(m_begin, m_top);
+        }
+
+        setChunk(0);
+        m_top = m_begin;
+        m_below = 0;
+    }
+
+    // Frees the chunks above the top one
+    void shrinkToFit()
+    {
+        while (m_chunks.size() > m_chunk)
+        {
+            m_capacity -= m_chunks.back().capacity;
+            ::operator delete(m_chunks.back().data, std::align_val_t { alignof(T) });
+            m_chunks.pop_back();
+        }
+    }
+
+    bool isEmpty() const { return m_top == m_begin; }
+    std::size_t getSize() const { return m_below + static_cast<std::size_t>(m_top - m_begin); }
+    std::size_t getCapacity() const { return m_capacity; }
+    std::size_t getChunkCount() const { return m_chunks.size(); }
+};
+
+#endif
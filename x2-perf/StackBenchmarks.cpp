@@ -0,0 +1,332 @@
+#include "ConcurrentStack.h"
+#include "Stack.h"
+#include "Suites.h"
+#include "Threads.h"
+
+#include <algorithm>
+#include <cstdint> // for std::int64_t, std::uint64_t
+#include <memory> // for std::shared_ptr, std::unique_ptr
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stack>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+    // Same record as 11-arrays-strings-dynamic-allocation/sort_student_grades.cpp
+    struct Student
+    {
+        std::string name { };
+        int grade { };
+    };
+
+    constexpr std::size_t g_blockSize { 256 }; // elements per pushRange / popN call
+
+    int getValue(int value)
+    {
+        return value;
+    }
+
+    int getValue(const Student& student)
+    {
+        return student.grade;
+    }
+
+    template <typename T>
+    T makeElement(std::size_t i)
+    {
+        if constexpr (std::is_same_v<T, Student>)
+        {
+            return { "Student", static_cast<int>(i % 101) };
+        }
+        else
+        {
+            return static_cast<T>(i % 101);
+        }
+    }
+
+    // Every run starts from an empty container, so growth (and std::vector's reallocation
+    // copies) is part of what is timed. The sum of the popped values checks the result. Only the
+    // current size is kept in memory.
+    template <typename T>
+    class StackFixture
+    {
+    private:
+        std::size_t m_size { };
+        bool m_hasData { false };
+
+    public:
+        std::vector<T> input { };
+        std::int64_t expected { };
+        std::int64_t sum { };
+
+        void prepare(std::size_t size)
+        {
+            if (m_hasData && m_size == size)
+            {
+                return;
+            }
+
+            input.clear();
+            expected = 0;
+            for (std::size_t i { 0 }; i < size; ++i)
+            {
+                input.push_back(makeElement<T>(i));
+                expected += getValue(input.back());
+            }
+
+            m_size = size;
+            m_hasData = true;
+        }
+    };
+
+    template <typename T>
+    void addStackTypeCases(BenchmarkSuite& suite, const SuiteOptions& options, std::string_view typeName)
+    {
+        auto fixture { std::make_shared<StackFixture<T>>() };
+
+        for (std::size_t size { options.minSize }; size <= options.maxSize; size *= 10)
+        {
+            const std::string group { "stack/" + std::string { typeName } + "/" + std::to_string(size) };
+            const auto items { static_cast<double>(size) };
+            const auto bytes { static_cast<double>(size * sizeof(T)) };
+            auto setup { [fixture, size]() { fixture->prepare(size); } };
+            auto checkSum { [fixture]() { return fixture->sum == fixture->expected; } };
+
+            suite.add({
+                group, "std::vector", setup,
+                [fixture]()
+                {
+                    std::vector<T> stack { };
+                    for (const T& element : fixture->input)
+                    {
+                        stack.push_back(element);
+                    }
+
+                    std::int64_t sum { 0 };
+                    while (!stack.empty())
+                    {
+                        sum += getValue(stack.back());
+                        stack.pop_back();
+                    }
+
+                    fixture->sum = sum;
+                },
+                checkSum, items, bytes,
+            });
+
+            suite.add({
+                group, "std::stack", setup,
+                [fixture]()
+                {
+                    std::stack<T> stack { };
+                    for (const T& element : fixture->input)
+                    {
+                        stack.push(element);
+                    }
+
+                    std::int64_t sum { 0 };
+                    while (!stack.empty())
+                    {
+                        sum += getValue(stack.top());
+                        stack.pop();
+                    }
+
+                    fixture->sum = sum;
+                },
+                checkSum, items, bytes,
+            });
+
+            suite.add({
+                group, "Stack", setup,
+                [fixture]()
+                {
+                    Stack<T> stack { };
+                    for (const T& element : fixture->input)
+                    {
+                        stack.push(element);
+                    }
+
+                    std::int64_t sum { 0 };
+                    while (!stack.isEmpty())
+                    {
+                        sum += getValue(stack.pop());
+                    }
+
+                    fixture->sum = sum;
+                },
+                checkSum, items, bytes,
+            });
+
+            suite.add({
+                group, "Stack/pushRange+popN", setup,
+                [fixture]()
+                {
+                    Stack<T> stack { };
+                    const std::span<const T> input { fixture->input };
+                    for (std::size_t first { 0 }; first < input.size(); first += g_blockSize)
+                    {
+                        stack.pushRange(input.subspan(first, std::min(g_blockSize, input.size() - first)));
+                    }
+
+                    std::vector<T> block(g_blockSize);
+                    std::int64_t sum { 0 };
+                    while (!stack.isEmpty())
+                    {
+                        const std::span<T> popped { block.data(), std::min(g_blockSize, stack.getSize()) };
+                        stack.popN(popped);
+                        for (const T& element : popped)
+                        {
+                            sum += getValue(element);
+                        }
+                    }
+
+                    fixture->sum = sum;
+                },
+                checkSum, items, bytes,
+            });
+
+            if (size == 0)
+            {
+                break;
+            }
+        }
+    }
+}
+
+namespace
+{
+    // Every thread pushes a value tagged with its index and pops one (not necessarily its own),
+    // ops times, so the stack never runs dry. The check is the MPMC stress test: everything
+    // popped, plus whatever is left, must be exactly the values pushed.
+    struct ConcurrentFixture
+    {
+        std::unique_ptr<ConcurrentStack<std::uint64_t>> stack { };
+        Stack<std::uint64_t> lockedStack { };
+        std::mutex mutex { };
+        std::vector<std::vector<std::uint64_t>> popped { };
+        std::size_t opsPerThread { };
+
+        void prepare(unsigned threads, std::size_t ops, std::uint32_t eliminationSlots)
+        {
+            stack = std::make_unique<ConcurrentStack<std::uint64_t>>(std::max<std::size_t>(threads, 64), eliminationSlots);
+            lockedStack.reset();
+            opsPerThread = ops / threads;
+            popped.assign(threads, { });
+            for (auto& values : popped)
+            {
+                values.reserve(opsPerThread);
+            }
+        }
+
+        bool isValid(unsigned threads)
+        {
+            std::vector<std::uint64_t> all { };
+            for (const auto& values : popped)
+            {
+                all.insert(all.end(), values.begin(), values.end());
+            }
+
+            while (std::optional<std::uint64_t> value { stack->pop() })
+            {
+                all.push_back(*value);
+            }
+
+            while (!lockedStack.isEmpty())
+            {
+                all.push_back(lockedStack.pop());
+            }
+
+            std::sort(all.begin(), all.end());
+
+            std::vector<std::uint64_t> expected { };
+            for (std::uint64_t thread { 0 }; thread < threads; ++thread)
+            {
+                for (std::uint64_t i { 0 }; i < opsPerThread; ++i)
+                {
+                    expected.push_back((thread << 32) | i);
+                }
+            }
+
+            return all == expected;
+        }
+    };
+
+    std::uint64_t makeValue(unsigned thread, std::size_t i)
+    {
+        return (std::uint64_t { thread } << 32) | i;
+    }
+}
+
+void addStackCases(BenchmarkSuite& suite, const SuiteOptions& options)
+{
+    addStackTypeCases<int>(suite, options, "int");
+    addStackTypeCases<Student>(suite, options, "Student");
+}
+
+void addStackConcurrentCases(BenchmarkSuite& suite, const SuiteOptions& options)
+{
+    auto fixture { std::make_shared<ConcurrentFixture>() };
+
+    for (std::size_t size { options.minSize }; size <= options.maxSize; size *= 10)
+    {
+        const std::string group { "stack-concurrent/" + std::to_string(size) };
+
+        for (unsigned threads { 1 }; threads <= options.maxThreads; threads *= 2)
+        {
+            // one push and one pop per op
+            const auto items { static_cast<double>(2 * (size / threads) * threads) };
+            const std::string suffix { "/" + std::to_string(threads) + "t" };
+            auto check { [fixture, threads]() { return fixture->isValid(threads); } };
+
+            suite.add({
+                group, "mutex+Stack" + suffix,
+                [fixture, threads, size]() { fixture->prepare(threads, size, 0); },
+                [fixture, threads]()
+                {
+                    runOnThreads(threads,
+                        [&fixture = *fixture](unsigned thread)
+                        {
+                            for (std::size_t i { 0 }; i < fixture.opsPerThread; ++i)
+                            {
+                                std::scoped_lock lock { fixture.mutex };
+                                fixture.lockedStack.push(makeValue(thread, i));
+                                fixture.popped[thread].push_back(fixture.lockedStack.pop());
+                            }
+                        });
+                },
+                check, items, 0.0, threads,
+            });
+
+            for (std::uint32_t slots : { 0u, 8u })
+            {
+                suite.add({
+                    group, std::string { (slots == 0) ? "treiber" : "treiber+elimination" } + suffix,
+                    [fixture, threads, size, slots]() { fixture->prepare(threads, size, slots); },
+                    [fixture, threads]()
+                    {
+                        runOnThreads(threads,
+                            [&fixture = *fixture](unsigned thread)
+                            {
+                                for (std::size_t i { 0 }; i < fixture.opsPerThread; ++i)
+                                {
+                                    fixture.stack->push(makeValue(thread, i));
+                                    fixture.popped[thread].push_back(*fixture.stack->pop());
+                                }
+                            });
+                    },
+                    check, items, 0.0, threads,
+                });
+            }
+        }
+
+        if (size == 0)
+        {
+            break;
+        }
+    }
+}
@@ -0,0 +1,194 @@
+#ifndef STATICSEARCH_H
+#define STATICSEARCH_H
+
+#include <array>
+#include <cassert>
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint32_t, std::uint64_t
+
+// Lookups in fixed (constexpr) sorted tables such as keyword or enum value lists. Everything is
+// constexpr, so a table can be checked with static_assert, and a lookup with a constant target
+// folds away entirely. All return the index of target, or -1, like binarySearch.
+
+// Branchless halving (branchlessSearch without the prefetch) over any constexpr array
+template <std::size_t N>
+constexpr int staticSearch(const std::array<int, N>& keys, int target)
+{
+    if constexpr (N == 0)
+    {
+        return -1;
+    }
+    else
+    {
+        std::size_t base { 0 };
+        std::size_t length { N };
+        while (length > 1)
+        {
+            std::size_t half { length / 2 };
+            base = (keys[base + half] < target) ? base + half : base;
+            length -= half;
+        }
+
+        base += (keys[base] < target);
+        return (base < N && keys[base] == target) ? static_cast<int>(base) : -1;
+    }
+}
+
+// Fully unrolled comparison tree: the table is a template argument, so every probe position and
+// key is a constant and the compiler emits a nest of compares against immediates, with no loads.
+template <std::array Keys, std::size_t Low = 0, std::size_t High = Keys.size()>
+constexpr int treeSearch(int target)
+{
+    if constexpr (Low == High)
+    {
+        return -1;
+    }
+    else
+    {
+        constexpr std::size_t center { Low + (High - Low) / 2 };
+
+        if (target < Keys[center])
+        {
+            return treeSearch<Keys, Low, center>(target);
+        }
+        else if (Keys[center] < target)
+        {
+            return treeSearch<Keys, center + 1, High>(target);
+        }
+
+        return static_cast<int>(center);
+    }
+}
+
+namespace perfect
+{
+    constexpr std::uint64_t nextMultiplier(std::uint64_t& state)
+    {
+        // splitmix64, forced odd
+        state += 0x9e3779b97f4a7c15;
+        std::uint64_t z { state };
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+        return (z ^ (z >> 31)) | 1;
+    }
+
+    constexpr std::size_t hash(int key, std::uint64_t multiplier, int bits)
+    {
+        return static_cast<std::size_t>((static_cast<std::uint32_t>(key) * multiplier) >> (64 - bits));
+    }
+
+    inline constexpr int g_maxTries { 256 };
+
+    // table sizes go from 2N slots (enough for evenly spaced keys) to about N^2 / 2 slots, where
+    // a random multiplier has no collision with probability ~1/e
+    constexpr int minimumBits(std::size_t count)
+    {
+        int bits { 1 };
+        while ((std::size_t { 1 } << bits) < 2 * count)
+        {
+            ++bits;
+        }
+
+        return bits;
+    }
+
+    constexpr int maximumBits(std::size_t count)
+    {
+        return minimumBits(count * count / 4 + count);
+    }
+
+    // the first of g_maxTries multipliers that sends every key to its own slot of a 2^bits
+    // table, or 0
+    template <std::size_t N>
+    constexpr std::uint64_t findMultiplier(const std::array<int, N>& keys, int bits)
+    {
+        // slot -> last attempt that filled it, so nothing needs clearing between attempts
+        std::array<int, (std::size_t { 1 } << maximumBits(N))> filledBy { };
+
+        std::uint64_t state { 0 };
+        for (int attempt { 1 }; attempt <= g_maxTries; ++attempt)
+        {
+            const std::uint64_t multiplier { nextMultiplier(state) };
+
+            bool collision { false };
+            for (std::size_t i { 0 }; i < N && !collision; ++i)
+            {
+                const std::size_t slot { hash(keys[i], multiplier, bits) };
+                collision = (filledBy[slot] == attempt);
+                filledBy[slot] = attempt;
+            }
+
+            if (!collision)
+            {
+                return multiplier;
+            }
+        }
+
+        return 0;
+    }
+}
+
+// Smallest power-of-two table with a collision-free multiplier. Meant for keyword and enum
+// tables of up to a few hundred keys: random-looking keys need ~N^2 / 2 slots.
+template <std::size_t N>
+constexpr int perfectHashBits(const std::array<int, N>& keys)
+{
+    for (int bits { perfect::minimumBits(N) }; bits <= perfect::maximumBits(N); ++bits)
+    {
+        if (perfect::findMultiplier(keys, bits) != 0)
+        {
+            return bits;
+        }
+    }
+
+    assert(false && "No perfect hash found; are the keys unique?");
+    return 0;
+}
+
+// Multiplicative perfect hash of a constexpr key set: one multiply, one shift, one compare.
+// Empty slots hold index -1, so a target that lands on one misses whatever key is stored there.
+template <std::size_t N, int Bits>
+struct PerfectHash
+{
+    static constexpr std::size_t s_slots { std::size_t { 1 } << Bits };
+
+    std::uint64_t multiplier { };
+    std::array<int, s_slots> keys { };
+    std::array<int, s_slots> indexes { };
+
+    constexpr int find(int target) const
+    {
+        const std::size_t slot { perfect::hash(target, multiplier, Bits) };
+        return (keys[slot] == target) ? indexes[slot] : -1;
+    }
+};
+
+template <int Bits, std::size_t N>
+constexpr PerfectHash<N, Bits> makePerfectHash(const std::array<int, N>& keys)
+{
+    PerfectHash<N, Bits> table { };
+    table.multiplier = perfect::findMultiplier(keys, Bits);
+    assert(table.multiplier != 0 && "No perfect hash for this table size");
+
+    table.indexes.fill(-1);
+    for (std::size_t i { 0 }; i < N; ++i)
+    {
+        const std::size_t slot { perfect::hash(keys[i], table.multiplier, Bits) };
+        table.keys[slot] = keys[i];
+        table.indexes[slot] = static_cast<int>(i);
+    }
+
+    return table;
+}
+
+// The table for Keys, built once at compile time
+template <std::array Keys>
+inline constexpr auto g_perfectHash { makePerfectHash<perfectHashBits(Keys)>(Keys) };
+
+template <std::array Keys>
+constexpr int perfectHashSearch(int target)
+{
+    return g_perfectHash<Keys>.find(target);
+}
+
+#endif
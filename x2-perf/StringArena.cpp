@@ -0,0 +1,51 @@
+#include "StringArena.h"
+
+#include <algorithm>
+#include <cstring> // for std::memcpy
+
+StringArena::StringArena(std::size_t blockSize)
+    : m_blockSize { blockSize }
+{
+}
+
+std::size_t StringArena::getGrowth(std::size_t size) const
+{
+    if (!m_blocks.empty() && m_capacity - m_used >= size)
+    {
+        return 0;
+    }
+
+    // strings longer than a block get a block of their own
+    return std::max(m_blockSize, size);
+}
+
+std::string_view StringArena::add(std::string_view string)
+{
+    if (const std::size_t growth { getGrowth(string.size()) }; growth != 0)
+    {
+        m_capacity = growth;
+        m_blocks.push_back(std::make_unique<char[]>(m_capacity));
+        m_used = 0;
+        m_allocatedBytes += m_capacity;
+    }
+
+    char* destination { m_blocks.back().get() + m_used };
+    if (!string.empty())
+    {
+        std::memcpy(destination, string.data(), string.size());
+    }
+
+    m_used += string.size();
+    m_totalBytes += string.size();
+
+    return { destination, string.size() };
+}
+
+void StringArena::clear()
+{
+    m_blocks.clear();
+    m_used = 0;
+    m_capacity = 0;
+    m_totalBytes = 0;
+    m_allocatedBytes = 0;
+}
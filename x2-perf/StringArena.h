@@ -0,0 +1,37 @@
+#ifndef STRINGARENA_H
+#define STRINGARENA_H
+
+#include <cstddef> // for std::size_t
+#include <memory> // for std::unique_ptr
+#include <string_view>
+#include <vector>
+
+// Stores many strings back to back in big blocks instead of one heap allocation per string.
+// The returned views stay valid until the arena is cleared or destroyed (blocks never move).
+class StringArena
+{
+private:
+    std::vector<std::unique_ptr<char[]>> m_blocks { };
+    std::size_t m_blockSize { };
+    std::size_t m_used { };      // bytes used in the last block
+    std::size_t m_capacity { };  // size of the last block
+    std::size_t m_totalBytes { };
+    std::size_t m_allocatedBytes { };
+
+public:
+    explicit StringArena(std::size_t blockSize = 1 << 20);
+
+    std::string_view add(std::string_view string);
+    void clear();
+
+    // bytes handed out so far, not counting unused block space
+    std::size_t getBytes() const { return m_totalBytes; }
+
+    // bytes of all blocks, used or not
+    std::size_t getAllocatedBytes() const { return m_allocatedBytes; }
+
+    // bytes of the new block add() would allocate for a string of this size, 0 if it still fits
+    std::size_t getGrowth(std::size_t size) const;
+};
+
+#endif
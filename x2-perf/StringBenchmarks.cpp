@@ -0,0 +1,241 @@
+#include "ExternalSort.h"
+#include "StringArena.h"
+#include "StringSort.h"
+#include "Suites.h"
+
+#include <algorithm>
+#include <memory> // for std::shared_ptr
+#include <random>
+#include <span>
+#include <sstream> // for std::istringstream, std::ostringstream
+#include <string>
+#include <string_view>
+#include <utility> // for std::move
+#include <vector>
+
+namespace
+{
+    constexpr std::string_view g_lastNames[] {
+        "Anderson", "Andersen", "Bakker", "Baker", "Chen", "Christensen", "Christiansen", "Dubois",
+        "Fernandez", "Fernandes", "Garcia", "Gonzalez", "Hansen", "Hanson", "Ivanov", "Ivanova",
+        "Johansson", "Johnson", "Kowalski", "Kowalska", "Larsen", "Martin", "Martinez", "Muller",
+        "Nguyen", "Novak", "Petrov", "Petrova", "Rossi", "Schmidt", "Smith", "Smirnov",
+    };
+
+    constexpr std::string_view g_firstNames[] {
+        "Adam", "Adrian", "Alexander", "Alexandra", "Anna", "Anne", "Christine", "Christopher",
+        "Daniel", "Daniela", "Elena", "Francis", "Francisco", "Greg", "Hagrid", "Maria",
+        "Mariana", "Michael", "Michelle", "Peter", "Petra", "Sofia", "Thomas", "Victoria",
+    };
+
+    // "Lastname, Firstname 12345": lots of shared prefixes, like a real list of names
+    template <typename Visit>
+    void generateNames(std::size_t count, std::uint64_t seed, Visit visit)
+    {
+        std::mt19937_64 mt { seed };
+        std::uniform_int_distribution<std::size_t> lastName { 0, std::size(g_lastNames) - 1 };
+        std::uniform_int_distribution<std::size_t> firstName { 0, std::size(g_firstNames) - 1 };
+        std::uniform_int_distribution number { 0, 99999 };
+
+        std::string name { };
+        for (std::size_t i { 0 }; i < count; ++i)
+        {
+            name.clear();
+            name.append(g_lastNames[lastName(mt)]).append(", ").append(g_firstNames[firstName(mt)]);
+            name.append(" ").append(std::to_string(number(mt)));
+            visit(name);
+        }
+    }
+
+    std::vector<std::string> makeNames(std::size_t count, std::uint64_t seed)
+    {
+        std::vector<std::string> names { };
+        names.reserve(count);
+        generateNames(count, seed, [&names](const std::string& name) { names.push_back(name); });
+        return names;
+    }
+
+    std::size_t getNameBytes(std::size_t count, std::uint64_t seed)
+    {
+        std::size_t bytes { 0 };
+        generateNames(count, seed, [&bytes](const std::string& name) { bytes += name.size(); });
+        return bytes;
+    }
+
+    // The names of the current size, as strings and as views into an arena, made once per size
+    class StringFixture
+    {
+    private:
+        std::uint64_t m_seed { };
+        std::size_t m_size { };
+        bool m_hasInput { false };
+
+    public:
+        std::vector<std::string> input { };
+        std::vector<std::string> work { };
+        StringArena arena { };
+        std::vector<std::string_view> arenaInput { };
+        std::vector<std::string_view> arenaWork { };
+
+        explicit StringFixture(std::uint64_t seed)
+            : m_seed { seed }
+        {
+        }
+
+        void prepare(std::size_t size)
+        {
+            if (m_hasInput && m_size == size)
+            {
+                return;
+            }
+
+            // free the previous size first, so only one is ever in memory
+            input = { };
+            work = { };
+            arenaInput = { };
+            arenaWork = { };
+            arena.clear();
+
+            input = makeNames(size, m_seed);
+            arenaInput.reserve(size);
+            for (const auto& name : input)
+            {
+                arenaInput.push_back(arena.add(name));
+            }
+
+            m_size = size;
+            m_hasInput = true;
+        }
+    };
+}
+
+void addSortStringsCases(BenchmarkSuite& suite, const SuiteOptions& options)
+{
+    auto fixture { std::make_shared<StringFixture>(options.seed) };
+
+    for (std::size_t size { options.minSize }; size <= options.maxSize; size *= 10)
+    {
+        const auto items { static_cast<double>(size) };
+        const auto bytes { static_cast<double>(getNameBytes(size, options.seed)) };
+        const std::string group { "sort-strings/" + std::to_string(size) };
+
+        auto copyStrings {
+            [fixture, size]()
+            {
+                fixture->prepare(size);
+                fixture->work = fixture->input;
+            }
+        };
+        auto stringsSorted { [fixture]() { return std::is_sorted(fixture->work.begin(), fixture->work.end()); } };
+        auto copyViews {
+            [fixture, size]()
+            {
+                fixture->prepare(size);
+                fixture->arenaWork = fixture->arenaInput;
+            }
+        };
+        auto viewsSorted {
+            [fixture]() { return std::is_sorted(fixture->arenaWork.begin(), fixture->arenaWork.end()); }
+        };
+
+        suite.add({
+            group, "std::sort(string)", copyStrings,
+            [fixture]() { std::sort(fixture->work.begin(), fixture->work.end()); },
+            stringsSorted, items, bytes,
+        });
+
+        suite.add({
+            group, "stringSort(string)", copyStrings,
+            [fixture]() { stringSort(std::span<std::string> { fixture->work }); },
+            stringsSorted, items, bytes,
+        });
+
+        suite.add({
+            group, "std::sort(arena view)", copyViews,
+            [fixture]() { std::sort(fixture->arenaWork.begin(), fixture->arenaWork.end()); },
+            viewsSorted, items, bytes,
+        });
+
+        suite.add({
+            group, "stringSort(arena view)", copyViews,
+            [fixture]() { stringSort(std::span<std::string_view> { fixture->arenaWork }); },
+            viewsSorted, items, bytes,
+        });
+
+        if (size == 0)
+        {
+            break;
+        }
+    }
+}
+
+void addSortExternalCases(BenchmarkSuite& suite, const SuiteOptions& options)
+{
+    struct ExternalFixture
+    {
+        std::string input { };
+        std::string expected { }; // the lines of input, std::sorted
+        std::string output { };
+    };
+
+    for (std::size_t size { options.minSize }; size <= options.maxSize; size *= 10)
+    {
+        auto fixture { std::make_shared<ExternalFixture>() };
+        std::vector<std::string> names { makeNames(size, options.seed) };
+        for (const auto& name : names)
+        {
+            fixture->input.append(name).push_back('\n');
+        }
+
+        std::sort(names.begin(), names.end());
+        for (const auto& name : names)
+        {
+            fixture->expected.append(name).push_back('\n');
+        }
+
+        const auto items { static_cast<double>(size) };
+        const auto bytes { static_cast<double>(fixture->input.size()) };
+        const std::string group { "sort-external/" + std::to_string(size) };
+
+        auto isSorted { [fixture]() { return fixture->output == fixture->expected; } };
+
+        // Budgets relative to the input, since every line also costs its view and sort entry:
+        // 4x holds it all, input / 2 makes about 7 runs and input / 32 about 100, merged 16 at a time
+        struct Budget
+        {
+            std::string name { };
+            std::size_t memoryBytes { };
+            std::size_t maxFanIn { };
+        };
+
+        const Budget budgets[] {
+            { "memory=4x input", fixture->input.size() * 4, 64 },
+            { "memory=input/2", fixture->input.size() / 2, 64 },
+            { "memory=input/32/fan-in 16", fixture->input.size() / 32, 16 },
+        };
+
+        for (const auto& budget : budgets)
+        {
+            ExternalSortOptions sortOptions { };
+            sortOptions.memoryBytes = budget.memoryBytes;
+            sortOptions.maxFanIn = budget.maxFanIn;
+
+            suite.add({
+                group, budget.name, { },
+                [fixture, sortOptions]()
+                {
+                    std::istringstream in { fixture->input };
+                    std::ostringstream out { };
+                    externalSortLines(in, out, sortOptions);
+                    fixture->output = std::move(out).str();
+                },
+                isSorted, items, bytes,
+            });
+        }
+
+        if (size == 0)
+        {
+            break;
+        }
+    }
+}
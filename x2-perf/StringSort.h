@@ -0,0 +1,257 @@
+#ifndef STRINGSORT_H
+#define STRINGSORT_H
+
+#include "RecordSort.h" // for applyPermutation
+
+#include <algorithm>
+#include <bit> // for std::endian
+#include <cassert>
+#include <concepts> // for std::convertible_to
+#include <cstddef> // for std::ptrdiff_t, std::size_t
+#include <cstdint> // for std::uint32_t, std::uint64_t
+#include <cstring> // for std::memcpy
+#include <limits>
+#include <span>
+#include <string_view>
+#include <utility> // for std::swap
+#include <vector>
+
+// Multikey quicksort over 8-byte "characters" for collections of strings.
+//
+// std::sort on std::string compares from the first character every time and follows a heap
+// pointer on every comparison, even though most comparisons in a big list of names are decided
+// by the first few bytes, and later ones by bytes past a long shared prefix.
+//
+// Here every string becomes an entry with the next 8 bytes cached inline as a big-endian
+// integer, so most comparisons are one integer compare with no pointer chasing. Entries are
+// 3-way partitioned on that chunk; the "equal" partition has a common prefix 8 bytes longer,
+// so it reloads its chunks at depth + 8 and continues without ever comparing the shared prefix
+// again. Buckets smaller than g_stringInsertionSort fall back to insertion sort.
+//
+// Works on anything convertible to std::string_view: std::string, std::string_view, or views
+// into a StringArena. stringSortedOrder() returns a stable permutation like sortedOrder() in
+// RecordSort.h; stringSort() applies it.
+
+inline constexpr std::size_t g_stringInsertionSort { 16 };
+
+namespace strings
+{
+    struct Entry
+    {
+        std::uint64_t chunk { }; // bytes [depth, depth + 8), big-endian, zero padded
+        const char* data { };
+        std::uint32_t length { };
+        std::uint32_t index { };
+    };
+
+    inline std::uint64_t loadChunk(const char* data, std::size_t length, std::size_t depth)
+    {
+        std::uint64_t chunk { 0 };
+        if (depth < length)
+        {
+            std::memcpy(&chunk, data + depth, std::min<std::size_t>(8, length - depth));
+        }
+
+        if constexpr (std::endian::native == std::endian::little)
+        {
+            chunk = __builtin_bswap64(chunk);
+        }
+
+        return chunk;
+    }
+
+    // How many bytes of the chunk are real: 0..8, or 9 if the string goes on after the chunk.
+    // Breaks ties between "ab" and "ab\0", which have the same zero padded chunk.
+    inline std::size_t getTag(const Entry& entry, std::size_t depth)
+    {
+        return (entry.length <= depth) ? 0 : std::min<std::size_t>(entry.length - depth, 9);
+    }
+
+    // Negative, zero or positive like strcmp, for entries that agree on the first depth bytes
+    inline int compareChunks(const Entry& a, const Entry& b, std::size_t depth)
+    {
+        if (a.chunk != b.chunk)
+        {
+            return (a.chunk < b.chunk) ? -1 : 1;
+        }
+
+        std::size_t tagA { getTag(a, depth) };
+        std::size_t tagB { getTag(b, depth) };
+
+        return (tagA < tagB) ? -1 : (tagA > tagB);
+    }
+
+    inline bool lessFrom(const Entry& a, const Entry& b, std::size_t depth)
+    {
+        int chunks { compareChunks(a, b, depth) };
+        if (chunks != 0 || getTag(a, depth) < 9)
+        {
+            return chunks < 0 || (chunks == 0 && a.index < b.index);
+        }
+
+        std::string_view restA { a.data + depth + 8, a.length - depth - 8 };
+        std::string_view restB { b.data + depth + 8, b.length - depth - 8 };
+        int rest { restA.compare(restB) };
+
+        return rest < 0 || (rest == 0 && a.index < b.index);
+    }
+
+    inline void insertionSort(Entry* first, Entry* last, std::size_t depth)
+    {
+        for (Entry* current { first + 1 }; current < last; ++current)
+        {
+            Entry entry { *current };
+            Entry* position { current };
+
+            while (position != first && lessFrom(entry, *(position - 1), depth))
+            {
+                *position = *(position - 1);
+                --position;
+            }
+
+            *position = entry;
+        }
+    }
+
+    inline const Entry& medianOfThree(const Entry& a, const Entry& b, const Entry& c, std::size_t depth)
+    {
+        if (compareChunks(a, b, depth) < 0)
+        {
+            if (compareChunks(b, c, depth) < 0)
+            {
+                return b;
+            }
+            return (compareChunks(a, c, depth) < 0) ? c : a;
+        }
+
+        if (compareChunks(a, c, depth) < 0)
+        {
+            return a;
+        }
+        return (compareChunks(b, c, depth) < 0) ? c : b;
+    }
+
+    inline void sortBucket(Entry* first, Entry* last, std::size_t depth)
+    {
+        while (static_cast<std::size_t>(last - first) >= g_stringInsertionSort)
+        {
+            const Entry pivot { medianOfThree(*first, first[(last - first) / 2], *(last - 1), depth) };
+
+            // [first, less) < pivot, [less, current) == pivot, [greater, last) > pivot
+            Entry* less { first };
+            Entry* current { first };
+            Entry* greater { last };
+
+            while (current < greater)
+            {
+                int order { compareChunks(*current, pivot, depth) };
+                if (order < 0)
+                {
+                    std::swap(*less++, *current++);
+                }
+                else if (order > 0)
+                {
+                    std::swap(*current, *--greater);
+                }
+                else
+                {
+                    ++current;
+                }
+            }
+
+            // Only the smaller buckets recurse and the largest continues the loop, as in introsort's
+            // sortRange: any bucket but the largest holds at most half, so the stack stays O(log n).
+
+            // the equal bucket shares depth + 8 bytes; if the strings ended, they are all equal
+            if (getTag(pivot, depth) < 9)
+            {
+                std::sort(less, greater, [](const Entry& a, const Entry& b) { return a.index < b.index; });
+
+                if (less - first < last - greater)
+                {
+                    sortBucket(first, less, depth);
+                    first = greater;
+                }
+                else
+                {
+                    sortBucket(greater, last, depth);
+                    last = less;
+                }
+                continue;
+            }
+
+            for (Entry* entry { less }; entry != greater; ++entry)
+            {
+                entry->chunk = loadChunk(entry->data, entry->length, depth + 8);
+            }
+
+            const std::ptrdiff_t lessSize { less - first };
+            const std::ptrdiff_t equalSize { greater - less };
+            const std::ptrdiff_t greaterSize { last - greater };
+
+            if (equalSize >= lessSize && equalSize >= greaterSize)
+            {
+                sortBucket(first, less, depth);
+                sortBucket(greater, last, depth);
+                first = less;
+                last = greater;
+                depth += 8;
+            }
+            else if (lessSize >= greaterSize)
+            {
+                sortBucket(less, greater, depth + 8);
+                sortBucket(greater, last, depth);
+                last = less;
+            }
+            else
+            {
+                sortBucket(first, less, depth);
+                sortBucket(less, greater, depth + 8);
+                first = greater;
+            }
+        }
+
+        insertionSort(first, last, depth);
+    }
+}
+
+template <typename T>
+    requires std::convertible_to<const T&, std::string_view>
+std::vector<std::uint32_t> stringSortedOrder(std::span<const T> strings)
+{
+    assert(strings.size() <= std::numeric_limits<std::uint32_t>::max() && "Too many strings for 32-bit indices");
+
+    std::vector<strings::Entry> entries(strings.size());
+    for (std::size_t i { 0 }; i < strings.size(); ++i)
+    {
+        std::string_view string { strings[i] };
+        assert(string.size() <= std::numeric_limits<std::uint32_t>::max() && "String too long");
+
+        entries[i] = {
+            strings::loadChunk(string.data(), string.size(), 0),
+            string.data(),
+            static_cast<std::uint32_t>(string.size()),
+            static_cast<std::uint32_t>(i),
+        };
+    }
+
+    strings::sortBucket(entries.data(), entries.data() + entries.size(), 0);
+
+    std::vector<std::uint32_t> order(entries.size());
+    for (std::size_t i { 0 }; i < entries.size(); ++i)
+    {
+        order[i] = entries[i].index;
+    }
+
+    return order;
+}
+
+template <typename T>
+    requires std::convertible_to<const T&, std::string_view>
+void stringSort(std::span<T> strings)
+{
+    auto order { stringSortedOrder(std::span<const T> { strings }) };
+    applyPermutation(strings, std::span<const std::uint32_t> { order });
+}
+
+#endif
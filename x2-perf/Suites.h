@@ -0,0 +1,38 @@
+#ifndef SUITES_H
+#define SUITES_H
+
+#include "Benchmark.h"
+
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint64_t
+
+struct SuiteOptions
+{
+    std::size_t minSize { 1000 };          // sizes go minSize, 10 * minSize, ... up to maxSize
+    std::size_t maxSize { 1000000 };
+    std::size_t quadraticMaxSize { 10000 }; // O(n^2) algorithms are skipped above this
+    std::uint64_t seed { 5489 };
+    std::size_t swaps { 16 };              // for Distribution::sortedSwaps
+    unsigned maxThreads { 32 };            // thread counts go 1, 2, 4, ... up to this
+    std::size_t queries { 100000 };         // lookups per run for the search suites
+};
+
+void addSortCases(BenchmarkSuite& suite, const SuiteOptions& options);
+void addSortThreadsCases(BenchmarkSuite& suite, const SuiteOptions& options);
+void addSortSmallCases(BenchmarkSuite& suite, const SuiteOptions& options);
+void addSortRecordsCases(BenchmarkSuite& suite, const SuiteOptions& options);
+void addSortStringsCases(BenchmarkSuite& suite, const SuiteOptions& options);
+void addSortExternalCases(BenchmarkSuite& suite, const SuiteOptions& options);
+void addTopKCases(BenchmarkSuite& suite, const SuiteOptions& options);
+void addSearchCases(BenchmarkSuite& suite, const SuiteOptions& options);
+void addFindCases(BenchmarkSuite& suite, const SuiteOptions& options);
+void addFindMappedCases(BenchmarkSuite& suite, const SuiteOptions& options);
+void addStackCases(BenchmarkSuite& suite, const SuiteOptions& options);
+void addStackConcurrentCases(BenchmarkSuite& suite, const SuiteOptions& options);
+void addTaskCases(BenchmarkSuite& suite, const SuiteOptions& options);
+void addRandomCases(BenchmarkSuite& suite, const SuiteOptions& options);
+void addBoundedRandomCases(BenchmarkSuite& suite, const SuiteOptions& options);
+void addParallelRandomCases(BenchmarkSuite& suite, const SuiteOptions& options);
+void addHistogramCases(BenchmarkSuite& suite, const SuiteOptions& options);
+
+#endif
@@ -0,0 +1,132 @@
+#include "Scheduler.h"
+#include "Suites.h"
+#include "Threads.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint> // for std::uint32_t, std::uint64_t
+#include <memory> // for std::shared_ptr, std::unique_ptr
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Element i costs about 256 * i / size steps, so the last quarter of the indexes holds almost
+    // half of the work: equal static blocks leave the first threads idle at the end, stolen
+    // half-ranges don't
+    std::uint32_t doWork(std::size_t i, std::size_t size)
+    {
+        const std::size_t steps { 1 + 256 * i / size };
+        auto value { static_cast<std::uint32_t>(i) };
+        for (std::size_t step { 0 }; step < steps; ++step)
+        {
+            value = value * 1664525u + 1013904223u;
+        }
+
+        return value;
+    }
+
+    struct TaskFixture
+    {
+        std::unique_ptr<Scheduler> scheduler { };
+        std::vector<std::uint32_t> results { };
+        std::vector<std::uint32_t> expected { };
+        std::atomic<std::size_t> tasks { };
+
+        void prepare(std::size_t size, unsigned threads)
+        {
+            if (!scheduler || scheduler->getThreadCount() != threads)
+            {
+                scheduler.reset(); // the old workers go away before the new ones start
+                scheduler = std::make_unique<Scheduler>(threads);
+            }
+
+            if (expected.size() != size)
+            {
+                expected.resize(size);
+                for (std::size_t i { 0 }; i < size; ++i)
+                {
+                    expected[i] = doWork(i, size);
+                }
+            }
+
+            results.assign(size, 0);
+            tasks.store(0);
+        }
+    };
+}
+
+void addTaskCases(BenchmarkSuite& suite, const SuiteOptions& options)
+{
+    auto fixture { std::make_shared<TaskFixture>() };
+
+    for (std::size_t size { options.minSize }; size <= options.maxSize; size *= 10)
+    {
+        const std::string imbalancedGroup { "tasks/imbalanced/" + std::to_string(size) };
+        const std::string spawnGroup { "tasks/spawn/" + std::to_string(size) };
+        const auto items { static_cast<double>(size) };
+
+        for (unsigned threads { 1 }; threads <= options.maxThreads; threads *= 2)
+        {
+            const std::string suffix { "/" + std::to_string(threads) + "t" };
+            auto setup { [fixture, size, threads]() { fixture->prepare(size, threads); } };
+            auto checkResults { [fixture]() { return fixture->results == fixture->expected; } };
+
+            suite.add({
+                imbalancedGroup, "runOnThreads" + suffix, setup,
+                [fixture, threads]()
+                {
+                    const std::size_t size { fixture->results.size() };
+                    runOnThreads(threads,
+                        [&fixture = *fixture, size, threads](unsigned thread)
+                        {
+                            const std::size_t first { size * thread / threads };
+                            const std::size_t last { size * (thread + 1) / threads };
+                            for (std::size_t i { first }; i < last; ++i)
+                            {
+                                fixture.results[i] = doWork(i, size);
+                            }
+                        });
+                },
+                checkResults, items, 0.0, threads,
+            });
+
+            suite.add({
+                imbalancedGroup, "parallelFor" + suffix, setup,
+                [fixture]()
+                {
+                    const std::size_t size { fixture->results.size() };
+                    fixture->scheduler->parallelFor(0, size, 0,
+                        [&fixture = *fixture, size](std::size_t first, std::size_t last)
+                        {
+                            for (std::size_t i { first }; i < last; ++i)
+                            {
+                                fixture.results[i] = doWork(i, size);
+                            }
+                        });
+                },
+                checkResults, items, 0.0, threads,
+            });
+
+            // one task per index: the cost of spawning, stealing and syncing alone
+            suite.add({
+                spawnGroup, "parallelFor(grain 1)" + suffix, setup,
+                [fixture]()
+                {
+                    fixture->scheduler->parallelFor(0, fixture->results.size(), 1,
+                        [&fixture = *fixture](std::size_t, std::size_t)
+                        {
+                            fixture.tasks.fetch_add(1, std::memory_order_relaxed);
+                        });
+                },
+                [fixture]() { return fixture->tasks.load() == fixture->results.size(); },
+                items, 0.0, threads,
+            });
+        }
+
+        if (size == 0)
+        {
+            break;
+        }
+    }
+}
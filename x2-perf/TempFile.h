@@ -0,0 +1,52 @@
+#ifndef TEMPFILE_H
+#define TEMPFILE_H
+
+#include <filesystem>
+#include <random>
+#include <string>
+#include <string_view>
+#include <system_error> // for std::error_code
+#include <utility> // for std::move, std::swap
+
+// A unique path in directory (prefix-<random>extension); the file, if it was created, is removed
+// when the TempFile goes out of scope
+class TempFile
+{
+private:
+    std::filesystem::path m_path { };
+
+public:
+    TempFile(const std::filesystem::path& directory, std::string_view prefix, std::string_view extension)
+    {
+        static std::mt19937_64 s_mt { std::random_device { }() };
+        m_path = directory / (std::string { prefix } + "-" + std::to_string(s_mt()) + std::string { extension });
+    }
+
+    TempFile(const TempFile&) = delete;
+    TempFile& operator=(const TempFile&) = delete;
+
+    TempFile(TempFile&& other) noexcept
+        : m_path { std::move(other.m_path) }
+    {
+        other.m_path.clear();
+    }
+
+    TempFile& operator=(TempFile&& other) noexcept
+    {
+        std::swap(m_path, other.m_path);
+        return *this;
+    }
+
+    ~TempFile()
+    {
+        if (!m_path.empty())
+        {
+            std::error_code ignored { };
+            std::filesystem::remove(m_path, ignored);
+        }
+    }
+
+    const std::filesystem::path& getPath() const { return m_path; }
+};
+
+#endif
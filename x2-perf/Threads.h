@@ -0,0 +1,30 @@
+#ifndef THREADS_H
+#define THREADS_H
+
+#include <algorithm>
+#include <functional> // for std::ref
+#include <thread>
+#include <vector>
+
+inline unsigned getHardwareThreads()
+{
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Calls fn(threadIndex) for threadIndex 0..threadCount-1, index 0 on the calling thread,
+// and returns once all of them have finished
+template <typename Fn>
+void runOnThreads(unsigned threadCount, Fn&& fn)
+{
+    std::vector<std::jthread> threads { }; // jthread joins on destruction, even if fn(0) throws
+    threads.reserve(threadCount > 0 ? threadCount - 1 : 0);
+
+    for (unsigned i { 1 }; i < threadCount; ++i)
+    {
+        threads.emplace_back(std::ref(fn), i);
+    }
+
+    fn(0u);
+}
+
+#endif
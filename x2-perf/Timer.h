@@ -0,0 +1,27 @@
+#ifndef TIMER_H
+#define TIMER_H
+
+#include <chrono> // for std::chrono functions
+
+// Same Timer as in 13-basic-oop/ex/03_sort_perf_test.cpp
+class Timer
+{
+private:
+    using Clock = std::chrono::steady_clock;
+    using Second = std::chrono::duration<double, std::ratio<1>>;
+
+    std::chrono::time_point<Clock> m_beg { Clock::now() };
+
+public:
+    void reset()
+    {
+        m_beg = Clock::now();
+    }
+
+    double elapsed() const
+    {
+        return std::chrono::duration_cast<Second>(Clock::now() - m_beg).count();
+    }
+};
+
+#endif
@@ -0,0 +1,270 @@
+#ifndef TOPK_H
+#define TOPK_H
+
+#include "CpuFeatures.h"
+#include "Threads.h"
+
+#include <algorithm>
+#include <bit> // for std::countr_zero
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint32_t
+#include <span>
+#include <vector>
+
+#ifdef CPUFEATURES_X86
+#include <immintrin.h>
+#endif
+
+// "Top k of N" instead of a single std::max_element.
+//
+// Comparators follow highestGrade in 06_best_student.cpp: comp(a, b) is true when a is worse
+// than b, so the top k are the k largest under comp. Results come back best first.
+//
+//   topK          - one pass with a bounded heap of k elements. An element only touches the
+//                   heap if it beats the current k-th best, so for N >> k almost every element
+//                   costs one comparison.
+//   topKSelect    - copies the input with positions and uses quickselect (std::nth_element).
+//                   Better when k is a large fraction of N.
+//   topKIndices   - int scores only: the same bounded heap over indices, but the "does it beat
+//                   the k-th best" test runs 8 scores per AVX2 compare-and-movemask.
+//   parallelTopK / parallelTopKIndices - every thread finds the top k of its chunk, then the
+//                   per-thread results are merged.
+//
+// When several elements tie with the k-th best, the earliest ones win, and equal elements come
+// back in input order.
+
+namespace topk
+{
+    // An element and its position in the input, so that equal elements can rank by position
+    template <typename T>
+    struct Ranked
+    {
+        T value { };
+        std::size_t index { };
+    };
+
+    // "a ranks ahead of b": better under comp, or equal and earlier
+    template <typename T, typename Compare>
+    auto makeBetterFirst(Compare& comp)
+    {
+        return [&comp](const Ranked<T>& a, const Ranked<T>& b)
+        {
+            return comp(b.value, a.value) || (!comp(a.value, b.value) && a.index < b.index);
+        };
+    }
+
+    template <typename T>
+    std::vector<T> getValues(const std::vector<Ranked<T>>& ranked)
+    {
+        std::vector<T> values { };
+        values.reserve(ranked.size());
+        for (const Ranked<T>& element : ranked)
+        {
+            values.push_back(element.value);
+        }
+
+        return values;
+    }
+
+    // First index >= start whose score is above threshold, or scores.size()
+    inline std::size_t findAboveScalar(std::span<const int> scores, std::size_t start, int threshold)
+    {
+        for (std::size_t i { start }; i < scores.size(); ++i)
+        {
+            if (scores[i] > threshold)
+            {
+                return i;
+            }
+        }
+
+        return scores.size();
+    }
+
+#ifdef CPUFEATURES_X86
+    __attribute__((target("avx2"))) inline std::size_t findAboveAvx2(std::span<const int> scores,
+        std::size_t start, int threshold)
+    {
+        const __m256i limit { _mm256_set1_epi32(threshold) };
+        std::size_t i { start };
+
+        for (; i + 8 <= scores.size(); i += 8)
+        {
+            __m256i block { _mm256_loadu_si256(reinterpret_cast<const __m256i*>(scores.data() + i)) };
+            auto mask { static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(block, limit)))) };
+
+            if (mask != 0)
+            {
+                return i + static_cast<std::size_t>(std::countr_zero(mask));
+            }
+        }
+
+        return findAboveScalar(scores, i, threshold);
+    }
+#endif
+
+    inline std::size_t findAbove(std::span<const int> scores, std::size_t start, int threshold)
+    {
+#ifdef CPUFEATURES_X86
+        if (hasAvx2())
+        {
+            return findAboveAvx2(scores, start, threshold);
+        }
+#endif
+        return findAboveScalar(scores, start, threshold);
+    }
+}
+
+template <typename T, typename Compare>
+std::vector<T> topK(std::span<const T> values, std::size_t k, Compare comp)
+{
+    std::vector<topk::Ranked<T>> heap { };
+    if (k == 0)
+    {
+        return { };
+    }
+    heap.reserve(std::min(k, values.size()));
+
+    // with betterFirst as the heap order, heap.front() is the worst element (the latest of equals)
+    auto betterFirst { topk::makeBetterFirst<T>(comp) };
+
+    for (std::size_t i { 0 }; i < values.size(); ++i)
+    {
+        if (heap.size() < k)
+        {
+            heap.push_back({ values[i], i });
+            std::push_heap(heap.begin(), heap.end(), betterFirst);
+        }
+        else if (comp(heap.front().value, values[i])) // a later equal element never gets in
+        {
+            std::pop_heap(heap.begin(), heap.end(), betterFirst);
+            heap.back() = { values[i], i };
+            std::push_heap(heap.begin(), heap.end(), betterFirst);
+        }
+    }
+
+    std::sort_heap(heap.begin(), heap.end(), betterFirst);
+    return topk::getValues(heap);
+}
+
+// Quickselect over (element, position) pairs, so ties at the k-th place go by position as in topK
+template <typename T, typename Compare>
+std::vector<T> topKSelect(std::span<const T> values, std::size_t k, Compare comp)
+{
+    std::vector<topk::Ranked<T>> ranked { };
+    ranked.reserve(values.size());
+    for (std::size_t i { 0 }; i < values.size(); ++i)
+    {
+        ranked.push_back({ values[i], i });
+    }
+    k = std::min(k, ranked.size());
+
+    auto betterFirst { topk::makeBetterFirst<T>(comp) };
+    auto kth { ranked.begin() + static_cast<std::ptrdiff_t>(k) };
+
+    std::nth_element(ranked.begin(), kth, ranked.end(), betterFirst);
+    ranked.erase(kth, ranked.end());
+    std::sort(ranked.begin(), ranked.end(), betterFirst);
+
+    return topk::getValues(ranked);
+}
+
+template <typename T, typename Compare>
+std::vector<T> parallelTopK(std::span<const T> values, std::size_t k, Compare comp, unsigned threadCount)
+{
+    threadCount = std::max(1u, threadCount);
+    std::vector<std::vector<T>> partial(threadCount);
+
+    runOnThreads(threadCount,
+        [&](unsigned thread)
+        {
+            std::size_t begin { values.size() * thread / threadCount };
+            std::size_t end { values.size() * (thread + 1) / threadCount };
+            partial[thread] = topK(values.subspan(begin, end - begin), k, comp);
+        });
+
+    // chunks are in input order, so ties still go to the earliest element
+    std::vector<T> merged { };
+    for (const auto& part : partial)
+    {
+        merged.insert(merged.end(), part.begin(), part.end());
+    }
+
+    return topK(std::span<const T> { merged }, k, comp);
+}
+
+// Indices of the k highest scores, best first (equal scores: lower index first).
+// offset is added to every returned index.
+inline std::vector<std::uint32_t> topKIndices(std::span<const int> scores, std::size_t k, std::uint32_t offset = 0)
+{
+    std::vector<std::uint32_t> heap { };
+    k = std::min(k, scores.size());
+    if (k == 0)
+    {
+        return heap;
+    }
+
+    auto betterFirst {
+        [scores, offset](std::uint32_t a, std::uint32_t b)
+        {
+            int scoreA { scores[a - offset] };
+            int scoreB { scores[b - offset] };
+            return scoreA > scoreB || (scoreA == scoreB && a < b);
+        }
+    };
+
+    for (std::size_t i { 0 }; i < k; ++i)
+    {
+        heap.push_back(static_cast<std::uint32_t>(i) + offset);
+    }
+    std::make_heap(heap.begin(), heap.end(), betterFirst); // front is the worst of the k
+
+    // later elements only get in with a strictly higher score than the current k-th best
+    int threshold { scores[heap.front() - offset] };
+    for (std::size_t i { topk::findAbove(scores, k, threshold) }; i < scores.size();
+        i = topk::findAbove(scores, i + 1, threshold))
+    {
+        std::pop_heap(heap.begin(), heap.end(), betterFirst);
+        heap.back() = static_cast<std::uint32_t>(i) + offset;
+        std::push_heap(heap.begin(), heap.end(), betterFirst);
+
+        threshold = scores[heap.front() - offset];
+    }
+
+    std::sort_heap(heap.begin(), heap.end(), betterFirst);
+    return heap;
+}
+
+inline std::vector<std::uint32_t> parallelTopKIndices(std::span<const int> scores, std::size_t k, unsigned threadCount)
+{
+    threadCount = std::max(1u, threadCount);
+    std::vector<std::vector<std::uint32_t>> partial(threadCount);
+
+    runOnThreads(threadCount,
+        [&](unsigned thread)
+        {
+            std::size_t begin { scores.size() * thread / threadCount };
+            std::size_t end { scores.size() * (thread + 1) / threadCount };
+            partial[thread] = topKIndices(scores.subspan(begin, end - begin), k, static_cast<std::uint32_t>(begin));
+        });
+
+    std::vector<std::uint32_t> merged { };
+    for (const auto& part : partial)
+    {
+        merged.insert(merged.end(), part.begin(), part.end());
+    }
+
+    auto betterFirst {
+        [scores](std::uint32_t a, std::uint32_t b)
+        {
+            return scores[a] > scores[b] || (scores[a] == scores[b] && a < b);
+        }
+    };
+
+    k = std::min(k, merged.size());
+    std::partial_sort(merged.begin(), merged.begin() + static_cast<std::ptrdiff_t>(k), merged.end(), betterFirst);
+    merged.resize(k);
+
+    return merged;
+}
+
+#endif
@@ -0,0 +1,227 @@
+#include "InputGenerators.h"
+#include "Suites.h"
+#include "Threads.h"
+#include "TopK.h"
+
+#include <algorithm>
+#include <cstdint> // for std::uint32_t
+#include <functional> // for std::greater, std::less
+#include <memory> // for std::shared_ptr
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    // Same record as 12-functions/ex/06_best_student.cpp
+    struct Student
+    {
+        std::string_view name { };
+        int points { };
+    };
+
+    struct TopKFixture
+    {
+        std::vector<int> scores { };
+        std::vector<Student> students { };
+        std::vector<int> expected { };   // top k scores, best first
+        std::vector<int> result { };
+
+        bool check() const
+        {
+            return result == expected;
+        }
+    };
+
+    // Few distinct scores, so many elements tie with the k-th best: only the earliest may win.
+    // Entries carry their position, which the comparator ignores, to tell equal scores apart.
+    struct TieFixture
+    {
+        struct Entry
+        {
+            int points { };
+            std::uint32_t position { };
+        };
+
+        std::vector<int> scores { };
+        std::vector<Entry> entries { };
+        std::vector<std::uint32_t> expected { }; // positions of the top k, best first
+        std::vector<std::uint32_t> result { };
+
+        void setResult(const std::vector<Entry>& best)
+        {
+            result.clear();
+            for (const Entry& entry : best)
+            {
+                result.push_back(entry.position);
+            }
+        }
+    };
+
+    std::vector<int> toScores(const std::vector<std::uint32_t>& indices, const std::vector<int>& scores)
+    {
+        std::vector<int> result { };
+        for (std::uint32_t index : indices)
+        {
+            result.push_back(scores[index]);
+        }
+
+        return result;
+    }
+
+    void addTopKTieCases(BenchmarkSuite& suite, const SuiteOptions& options, std::size_t size)
+    {
+        using Entry = TieFixture::Entry;
+
+        auto fewerPoints { [](const Entry& a, const Entry& b) { return a.points < b.points; } };
+        const auto scores { generateInput(Distribution::fewUnique, size, options.seed) };
+
+        for (std::size_t k : { std::size_t { 10 }, std::size_t { 1000 } })
+        {
+            auto fixture { std::make_shared<TieFixture>() };
+            fixture->scores = scores;
+            for (std::size_t i { 0 }; i < size; ++i)
+            {
+                fixture->entries.push_back({ scores[i], static_cast<std::uint32_t>(i) });
+            }
+
+            // a stable sort keeps equal scores in input order
+            std::vector<Entry> sorted { fixture->entries };
+            std::stable_sort(sorted.begin(), sorted.end(), [](const Entry& a, const Entry& b) { return a.points > b.points; });
+            sorted.resize(std::min(k, size));
+            fixture->setResult(sorted);
+            fixture->expected = fixture->result;
+
+            const std::string group { "topk/ties/" + std::to_string(size) + "/k=" + std::to_string(k) };
+            const auto items { static_cast<double>(size) };
+            const auto bytes { static_cast<double>(size * sizeof(Entry)) };
+            auto check { [fixture]() { return fixture->result == fixture->expected; } };
+            const unsigned threads { std::min(getHardwareThreads(), options.maxThreads) };
+
+            suite.add({
+                group, "topKSelect", { },
+                [fixture, k, fewerPoints]() { fixture->setResult(topKSelect(std::span<const Entry> { fixture->entries }, k, fewerPoints)); },
+                check, items, bytes,
+            });
+
+            suite.add({
+                group, "topK", { },
+                [fixture, k, fewerPoints]() { fixture->setResult(topK(std::span<const Entry> { fixture->entries }, k, fewerPoints)); },
+                check, items, bytes,
+            });
+
+            suite.add({
+                group, "parallelTopK/" + std::to_string(threads) + "t", { },
+                [fixture, k, fewerPoints, threads]()
+                {
+                    fixture->setResult(parallelTopK(std::span<const Entry> { fixture->entries }, k, fewerPoints, threads));
+                },
+                check, items, bytes, threads,
+            });
+
+            suite.add({
+                group, "topKIndices", { },
+                [fixture, k]() { fixture->result = topKIndices(std::span<const int> { fixture->scores }, k); },
+                check, items, static_cast<double>(size * sizeof(int)),
+            });
+
+            suite.add({
+                group, "parallelTopKIndices/" + std::to_string(threads) + "t", { },
+                [fixture, k, threads]() { fixture->result = parallelTopKIndices(std::span<const int> { fixture->scores }, k, threads); },
+                check, items, static_cast<double>(size * sizeof(int)), threads,
+            });
+        }
+    }
+}
+
+void addTopKCases(BenchmarkSuite& suite, const SuiteOptions& options)
+{
+    constexpr std::size_t ks[] { 10, 1000 };
+
+    auto highestGrade {
+        [](const Student& a, const Student& b)
+        {
+            return (a.points < b.points);
+        }
+    };
+
+    for (std::size_t size { options.minSize }; size <= options.maxSize; size *= 10)
+    {
+        auto scores { generateInput(Distribution::random, size, options.seed) };
+
+        for (std::size_t k : ks)
+        {
+            auto fixture { std::make_shared<TopKFixture>() };
+            fixture->scores = scores;
+            fixture->students.resize(size);
+            for (std::size_t i { 0 }; i < size; ++i)
+            {
+                fixture->students[i] = { "student", scores[i] };
+            }
+
+            fixture->expected = scores;
+            std::sort(fixture->expected.begin(), fixture->expected.end(), std::greater<> { });
+            fixture->expected.resize(std::min(k, size));
+
+            const std::string group { "topk/" + std::to_string(size) + "/k=" + std::to_string(k) };
+            const auto items { static_cast<double>(size) };
+            const auto bytes { static_cast<double>(size * sizeof(int)) };
+            auto check { [fixture]() { return fixture->check(); } };
+
+            suite.add({
+                group, "topKSelect", { },
+                [fixture, k]() { fixture->result = topKSelect(std::span<const int> { fixture->scores }, k, std::less<> { }); },
+                check, items, bytes,
+            });
+
+            suite.add({
+                group, "topK", { },
+                [fixture, k]() { fixture->result = topK(std::span<const int> { fixture->scores }, k, std::less<> { }); },
+                check, items, bytes,
+            });
+
+            suite.add({
+                group, "topK(Student)", { },
+                [fixture, k, highestGrade]()
+                {
+                    auto best { topK(std::span<const Student> { fixture->students }, k, highestGrade) };
+
+                    fixture->result.clear();
+                    for (const auto& student : best)
+                    {
+                        fixture->result.push_back(student.points);
+                    }
+                },
+                check, items, static_cast<double>(size * sizeof(Student)),
+            });
+
+            suite.add({
+                group, "topKIndices", { },
+                [fixture, k]()
+                {
+                    fixture->result = toScores(topKIndices(std::span<const int> { fixture->scores }, k), fixture->scores);
+                },
+                check, items, bytes,
+            });
+
+            const unsigned threads { std::min(getHardwareThreads(), options.maxThreads) };
+            suite.add({
+                group, "parallelTopKIndices/" + std::to_string(threads) + "t", { },
+                [fixture, k, threads]()
+                {
+                    fixture->result = toScores(parallelTopKIndices(std::span<const int> { fixture->scores }, k, threads),
+                        fixture->scores);
+                },
+                check, items, bytes, threads,
+            });
+        }
+
+        addTopKTieCases(suite, options, scores.size());
+
+        if (size == 0)
+        {
+            break;
+        }
+    }
+}
@@ -0,0 +1,143 @@
+#ifndef WORKDEQUE_H
+#define WORKDEQUE_H
+
+#include <atomic>
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::int64_t
+#include <memory> // for std::unique_ptr
+#include <vector>
+
+// Chase-Lev work-stealing deque of T* (Le, Pop, Cohen, Zappa Nardelli, "Correct and Efficient
+// Work-Stealing for Weak Memory Models", 2013). The owning thread uses it like the Stack from
+// 01_custom_stack.cpp: push and pop at the bottom, LIFO. Any other thread may steal the oldest
+// element from the top. Only the owner may call push and pop.
+template <typename T>
+class WorkDeque
+{
+private:
+    struct Buffer
+    {
+        std::int64_t capacity { };        // a power of two
+        std::unique_ptr<std::atomic<T*>[]> slots { };
+
+        explicit Buffer(std::int64_t bufferCapacity)
+            : capacity { bufferCapacity }
+            , slots { std::make_unique<std::atomic<T*>[]>(static_cast<std::size_t>(bufferCapacity)) }
+        {
+        }
+
+        std::atomic<T*>& at(std::int64_t index)
+        {
+            return slots[static_cast<std::size_t>(index & (capacity - 1))];
+        }
+    };
+
+    // thieves advance top, the owner moves bottom; kept on separate cache lines
+    alignas(64) std::atomic<std::int64_t> m_top { 0 };
+    alignas(64) std::atomic<std::int64_t> m_bottom { 0 };
+    std::atomic<Buffer*> m_buffer { };
+
+    // Every buffer ever used: a thief may still be reading an old one after the owner grew the
+    // deque, so they are only freed with the deque. Owner only.
+    std::vector<std::unique_ptr<Buffer>> m_buffers { };
+
+    Buffer* grow(Buffer* buffer, std::int64_t top, std::int64_t bottom)
+    {
+        m_buffers.push_back(std::make_unique<Buffer>(buffer->capacity * 2));
+        Buffer* grown { m_buffers.back().get() };
+        for (std::int64_t i { top }; i < bottom; ++i)
+        {
+            grown->at(i).store(buffer->at(i).load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+
+        m_buffer.store(grown, std::memory_order_release);
+        return grown;
+    }
+
+public:
+    explicit WorkDeque(std::int64_t capacity = 64)
+    {
+        m_buffers.push_back(std::make_unique<Buffer>(capacity));
+        m_buffer.store(m_buffers.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkDeque(const WorkDeque&) = delete;
+    WorkDeque& operator=(const WorkDeque&) = delete;
+
+    void push(T* element)
+    {
+        const std::int64_t bottom { m_bottom.load(std::memory_order_relaxed) };
+        const std::int64_t top { m_top.load(std::memory_order_acquire) };
+        Buffer* buffer { m_buffer.load(std::memory_order_relaxed) };
+        if (bottom - top > buffer->capacity - 1)
+        {
+            buffer = grow(buffer, top, bottom);
+        }
+
+        // release/acquire on the slot is free on x86 and also lets ThreadSanitizer, which ignores
+        // fences, see the hand-off to a thief
+        buffer->at(bottom).store(element, std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    // The newest element, or nullptr
+    T* pop()
+    {
+        const std::int64_t bottom { m_bottom.load(std::memory_order_relaxed) - 1 };
+        Buffer* buffer { m_buffer.load(std::memory_order_relaxed) };
+        m_bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t top { m_top.load(std::memory_order_relaxed) };
+
+        if (top > bottom)
+        {
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        T* element { buffer->at(bottom).load(std::memory_order_relaxed) };
+        if (top == bottom)
+        {
+            // the last element: race the thieves for it
+            if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                element = nullptr;
+            }
+
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        return element;
+    }
+
+    // The oldest element, or nullptr if the deque is empty or another thread got there first
+    T* steal()
+    {
+        std::int64_t top { m_top.load(std::memory_order_acquire) };
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const std::int64_t bottom { m_bottom.load(std::memory_order_acquire) };
+
+        if (top >= bottom)
+        {
+            return nullptr;
+        }
+
+        Buffer* buffer { m_buffer.load(std::memory_order_acquire) };
+        T* element { buffer->at(top).load(std::memory_order_acquire) };
+        if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            return nullptr;
+        }
+
+        return element;
+    }
+
+    // Only a snapshot unless called by the owner with no thieves around
+    bool isEmpty() const
+    {
+        return m_top.load(std::memory_order_seq_cst) >= m_bottom.load(std::memory_order_seq_cst);
+    }
+};
+
+#endif
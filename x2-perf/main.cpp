@@ -0,0 +1,294 @@
+#include "Benchmark.h"
+#include "ExternalSort.h"
+#include "Suites.h"
+
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint64_t
+#include <exception> // for std::exception
+#include <iostream>
+#include <sstream> // for std::stringstream
+#include <string>
+#include <string_view>
+
+namespace
+{
+    struct Suite
+    {
+        std::string_view name { };
+        std::string_view description { };
+        void (*addCases)(BenchmarkSuite&, const SuiteOptions&) { };
+    };
+
+    constexpr Suite g_suites[] {
+        { "sort", "every sort over every input distribution and size", addSortCases },
+        { "sort-threads", "parallelSort scaling over 1, 2, 4, ... threads", addSortThreadsCases },
+        { "sort-small", "sorting networks vs std::sort on many arrays of 4..32 elements", addSortSmallCases },
+        { "sort-records", "Student records: std::sort vs key-extracted sortByKey", addSortRecordsCases },
+        { "sort-strings", "lists of names: std::sort vs multikey quicksort", addSortStringsCases },
+        { "sort-external", "external merge sort of names under shrinking memory budgets", addSortExternalCases },
+        { "topk", "top k of N scores: bounded heap, quickselect, SIMD prefilter, threads", addTopKCases },
+        { "search", "binarySearch vs branchless, batched and index layouts (sizes are keys)", addSearchCases },
+        { "find", "findValue linear scan: scalar vs SSE2 / AVX2 / AVX-512, per element type", addFindCases },
+        { "find-mapped", "findValue over a memory-mapped file: one thread vs 1, 2, 4, ... threads", addFindMappedCases },
+        { "stack", "Stack (chunked, inline buffer) vs std::vector and std::stack push/pop, per element type", addStackCases },
+        { "stack-concurrent", "lock-free Treiber stack (with and without elimination) vs a mutex, 1, 2, 4, ... threads", addStackConcurrentCases },
+        { "tasks", "work-stealing Scheduler: parallelFor vs static runOnThreads blocks, and per-task cost", addTaskCases },
+        { "random", "LCG16 and std::mt19937 vs Pcg32, xoshiro256**, 8-lane (AVX2) xoshiro256** and Philox fill", addRandomCases },
+        { "bounded", "random integers in [0, n): % and uniform_int_distribution vs Lemire multiply-shift, batched", addBoundedRandomCases },
+        { "random-threads", "Philox counter-based fill split over 1, 2, 4, ... threads, identical for every count", addParallelRandomCases },
+        { "histogram", "one counter array vs buildHistogram (private replicated bins) over 1, 2, 4, ... threads", addHistogramCases },
+    };
+
+    void printUsage(std::string_view program)
+    {
+        std::cerr << "Usage: " << program << " <suite> [options]\n"
+            << "       " << program << " sort-lines [--memory=<bytes>] [--buffer=<bytes>] [--fan-in=<runs>]"
+            << " [--temp=<dir>] < input > output\n\n"
+            << "Suites:\n";
+
+        for (const auto& suite : g_suites)
+        {
+            std::cerr << "  " << suite.name << "\t" << suite.description << '\n';
+        }
+
+        std::cerr << "\nOptions:\n"
+            << "  --format=text|csv|json  output format (default text)\n"
+            << "  --target=<seconds>      timed wall time per case (default 0.5)\n"
+            << "  --warmup=<runs>         untimed warmup runs per case (default 2)\n"
+            << "  --min-runs=<runs>       lower bound for the automatic repeat count (default 5)\n"
+            << "  --filter=<text>         only run cases whose group/name contains text\n"
+            << "  --size=<elements>       only this input size, 1e6 notation is fine\n"
+            << "  --min-size=<elements>   smallest input size (default 1e3)\n"
+            << "  --max-size=<elements>   largest input size, sizes grow 10x (default 1e6)\n"
+            << "  --quadratic-max=<n>     skip O(n^2) sorts above this size (default 1e4)\n"
+            << "  --seed=<number>         seed for the input generators (default 5489)\n"
+            << "  --swaps=<count>         swaps for the sorted-swaps input (default 16)\n"
+            << "  --max-threads=<count>   largest thread count for scaling suites (default 32)\n"
+            << "  --queries=<count>       lookups per run for the search suites (default 1e5)\n";
+    }
+
+    // Accepts plain integers as well as 1e6-style notation
+    bool parseNumber(std::string_view text, double& number)
+    {
+        std::stringstream convert { std::string { text } };
+
+        return (convert >> number) && convert.eof();
+    }
+
+    bool parseOption(std::string_view arg, BenchmarkOptions& benchmarkOptions, SuiteOptions& suiteOptions,
+        OutputFormat& format)
+    {
+        auto equals { arg.find('=') };
+        if (arg.substr(0, 2) != "--" || equals == std::string_view::npos)
+        {
+            return false;
+        }
+
+        std::string_view key { arg.substr(2, equals - 2) };
+        std::string_view value { arg.substr(equals + 1) };
+
+        if (key == "format")
+        {
+            if (value == "text")
+            {
+                format = OutputFormat::text;
+            }
+            else if (value == "csv")
+            {
+                format = OutputFormat::csv;
+            }
+            else if (value == "json")
+            {
+                format = OutputFormat::json;
+            }
+            else
+            {
+                return false;
+            }
+
+            return true;
+        }
+
+        if (key == "filter")
+        {
+            benchmarkOptions.filter = value;
+            return true;
+        }
+
+        double number { };
+        if (!parseNumber(value, number) || number < 0.0)
+        {
+            return false;
+        }
+
+        if (key == "target")
+        {
+            benchmarkOptions.targetSeconds = number;
+        }
+        else if (key == "warmup")
+        {
+            benchmarkOptions.warmupRuns = static_cast<int>(number);
+        }
+        else if (key == "min-runs")
+        {
+            benchmarkOptions.minRuns = static_cast<int>(number);
+        }
+        else if (key == "size")
+        {
+            suiteOptions.minSize = static_cast<std::size_t>(number);
+            suiteOptions.maxSize = suiteOptions.minSize;
+        }
+        else if (key == "min-size")
+        {
+            suiteOptions.minSize = static_cast<std::size_t>(number);
+        }
+        else if (key == "max-size")
+        {
+            suiteOptions.maxSize = static_cast<std::size_t>(number);
+        }
+        else if (key == "quadratic-max")
+        {
+            suiteOptions.quadraticMaxSize = static_cast<std::size_t>(number);
+        }
+        else if (key == "seed")
+        {
+            suiteOptions.seed = static_cast<std::uint64_t>(number);
+        }
+        else if (key == "swaps")
+        {
+            suiteOptions.swaps = static_cast<std::size_t>(number);
+        }
+        else if (key == "max-threads")
+        {
+            suiteOptions.maxThreads = static_cast<unsigned>(number);
+        }
+        else if (key == "queries")
+        {
+            suiteOptions.queries = static_cast<std::size_t>(number);
+        }
+        else
+        {
+            return false;
+        }
+
+        return true;
+    }
+
+    // Sorts stdin to stdout line by line, spilling to temporary files past --memory
+    int sortLines(std::string_view program, int argc, char* argv[])
+    {
+        ExternalSortOptions options { };
+
+        for (int i { 2 }; i < argc; ++i)
+        {
+            std::string_view arg { argv[i] };
+            auto equals { arg.find('=') };
+            std::string_view key { (equals == std::string_view::npos) ? arg : arg.substr(0, equals) };
+            std::string_view value { (equals == std::string_view::npos) ? "" : arg.substr(equals + 1) };
+
+            double number { };
+            bool isNumber { parseNumber(value, number) && number >= 1.0 };
+
+            if (key == "--temp" && !value.empty())
+            {
+                options.tempDirectory = value;
+            }
+            else if (key == "--memory" && isNumber)
+            {
+                options.memoryBytes = static_cast<std::size_t>(number);
+            }
+            else if (key == "--buffer" && isNumber)
+            {
+                options.bufferBytes = static_cast<std::size_t>(number);
+            }
+            else if (key == "--fan-in" && isNumber)
+            {
+                options.maxFanIn = static_cast<std::size_t>(number);
+            }
+            else
+            {
+                std::cerr << "Invalid option: " << arg << "\n\n";
+                printUsage(program);
+                return 1;
+            }
+        }
+
+        std::ios::sync_with_stdio(false);
+
+        try
+        {
+            ExternalSortStats stats { externalSortLines(std::cin, std::cout, options) };
+            std::cout.flush();
+
+            std::cerr << "Sorted " << stats.lines << " lines (" << stats.bytes << " bytes) in " << stats.runs
+                << " run(s) and " << stats.mergePasses << " merge pass(es)\n";
+        }
+        catch (const std::exception& exception)
+        {
+            std::cerr << "Error: " << exception.what() << '\n';
+            return 1;
+        }
+
+        return std::cout ? 0 : 1;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::string_view program { (argc > 0 && argv[0]) ? argv[0] : "main.out" };
+
+    if (argc < 2)
+    {
+        printUsage(program);
+        return 1;
+    }
+
+    if (std::string_view { argv[1] } == "sort-lines")
+    {
+        return sortLines(program, argc, argv);
+    }
+
+    const Suite* selected { nullptr };
+    for (const auto& suite : g_suites)
+    {
+        if (suite.name == argv[1])
+        {
+            selected = &suite;
+        }
+    }
+
+    if (!selected)
+    {
+        std::cerr << "Unknown suite: " << argv[1] << "\n\n";
+        printUsage(program);
+        return 1;
+    }
+
+    BenchmarkOptions benchmarkOptions { };
+    SuiteOptions suiteOptions { };
+    OutputFormat format { OutputFormat::text };
+
+    for (int i { 2 }; i < argc; ++i)
+    {
+        if (!parseOption(argv[i], benchmarkOptions, suiteOptions, format))
+        {
+            std::cerr << "Invalid option: " << argv[i] << "\n\n";
+            printUsage(program);
+            return 1;
+        }
+    }
+
+    BenchmarkSuite suite { };
+    selected->addCases(suite, suiteOptions);
+
+    Reporter reporter { std::cout, format };
+    int failed { suite.run(benchmarkOptions, reporter) };
+
+    if (failed > 0)
+    {
+        std::cerr << failed << " case(s) produced wrong results\n";
+        return 1;
+    }
+
+    return 0;
+}